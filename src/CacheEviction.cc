@@ -0,0 +1,234 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <ctime>
+#include <map>
+#include <vector>
+
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/PathInfo.h>
+#include <zypp/RepoManager.h>
+
+#include "Zypper.h"
+#include "CacheEviction.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  /** Files evicted together (the hardlinks of a package or a raw metadata directory). */
+  struct Evictable
+  {
+    std::vector<Pathname> paths;
+    ByteCount size;
+    time_t used = 0;		///< last use
+    nlink_t nlink = 0;		///< links to a package file (0 for directories)
+  };
+
+  inline time_t lastUse( const PathInfo & pi_r )
+  { return std::max( pi_r.atime(), pi_r.mtime() ); }
+
+  /** Collect the package files below \a dir_r by inode. */
+  void scanPackages( const Pathname & dir_r, std::map<std::pair<dev_t,ino_t>,Evictable> & units_r )
+  {
+    filesystem::dirForEach( dir_r, [&units_r]( const Pathname & dir_r, const char *const name_r ) -> bool {
+      const Pathname & path { dir_r / name_r };
+      PathInfo pi( path, PathInfo::LSTAT );
+      if ( pi.isDir() )
+        scanPackages( path, units_r );
+      else if ( pi.isFile() )
+      {
+        Evictable & unit { units_r[{ pi.dev(), pi.ino() }] };
+        if ( unit.paths.empty() )
+        {
+          unit.size = pi.size();
+          unit.nlink = pi.nlink();
+        }
+        unit.used = std::max( unit.used, lastUse( pi ) );
+        unit.paths.push_back( path );
+      }
+      return true;
+    } );
+  }
+
+  /** Sum up size and latest modification of the files below \a dir_r. */
+  void scanDir( const Pathname & dir_r, Evictable & unit_r )
+  {
+    filesystem::dirForEach( dir_r, [&unit_r]( const Pathname & dir_r, const char *const name_r ) -> bool {
+      const Pathname & path { dir_r / name_r };
+      PathInfo pi( path, PathInfo::LSTAT );
+      if ( pi.isDir() )
+        scanDir( path, unit_r );
+      else
+      {
+        unit_r.size += pi.size();
+        unit_r.used = std::max( unit_r.used, pi.mtime() );
+      }
+      return true;
+    } );
+  }
+
+  inline std::list<Pathname> subdirs( const Pathname & dir_r )
+  {
+    std::list<Pathname> ret;
+    filesystem::dirForEach( dir_r, [&ret]( const Pathname & dir_r, const char *const name_r ) -> bool {
+      if ( PathInfo( dir_r / name_r, PathInfo::LSTAT ).isDir() )
+        ret.push_back( dir_r / name_r );
+      return true;
+    } );
+    return ret;
+  }
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+CacheEviction::CacheEviction( Zypper & zypper_r )
+{
+  const Config & config { zypper_r.config() };
+  _packageDirs.push_back( Pathname::assertprefix( config.root_dir, config.rm_options.repoPackagesCachePath ) );
+  _rawDirs = subdirs( Pathname::assertprefix( config.root_dir, config.rm_options.repoRawCachePath ) );
+
+  try
+  {
+    RepoManager & manager { zypper_r.repoManager() };
+    for_( it, manager.repoBegin(), manager.repoEnd() )
+    {
+      const RepoInfo & repo { *it };
+      if ( repo.enabled() || repo.url().schemeIsVolatile() )	// in use or cd/dvd
+        _keepRaw.insert( repo.metadataPath() );
+    }
+  }
+  catch ( const Exception & e )
+  {
+    // without the repos we can't tell which raw metadata to keep
+    ZYPP_CAUGHT( e );
+    WAR << "Can't read the repos, keeping all raw metadata." << endl;
+    _rawDirs.clear();
+  }
+}
+
+void CacheEviction::restrictTo( const std::list<RepoInfo> & repos_r )
+{
+  _packageDirs.clear();
+  _rawDirs.clear();
+  for ( const RepoInfo & repo : repos_r )
+  {
+    _packageDirs.push_back( repo.packagesPath() );
+    if ( ! _keepRaw.count( repo.metadataPath() ) )
+      _rawDirs.push_back( repo.metadataPath() );
+  }
+}
+
+CacheEviction::Result CacheEviction::evict( const Policy & policy_r ) const
+{
+  Result ret;
+  if ( policy_r.empty() )
+    return ret;
+
+  std::vector<Evictable> units;
+  {
+    std::map<std::pair<dev_t,ino_t>,Evictable> packages;
+    for ( const Pathname & dir : _packageDirs )
+      scanPackages( dir, packages );
+    for ( auto & p : packages )
+    {
+      // Evicting a package still linked elsewhere (e.g. by a repo we don't look at) frees nothing.
+      if ( p.second.nlink <= p.second.paths.size() )
+        units.push_back( std::move(p.second) );
+    }
+  }
+  for ( const Pathname & dir : _rawDirs )
+  {
+    if ( _keepRaw.count( dir ) || ! PathInfo( dir ).isDir() )
+      continue;
+    Evictable unit;
+    unit.paths.push_back( dir );
+    scanDir( dir, unit );
+    units.push_back( std::move(unit) );
+  }
+
+  for ( const Evictable & unit : units )
+    ret.size += unit.size;
+  ByteCount total { ret.size };
+
+  std::sort( units.begin(), units.end(), []( const Evictable & lhs, const Evictable & rhs ) { return lhs.used < rhs.used; } );
+  time_t expired = policy_r.maxAge ? ::time( nullptr ) - time_t(policy_r.maxAge) * 24 * 60 * 60 : 0;
+
+  for ( const Evictable & unit : units )
+  {
+    bool tooOld = unit.used < expired;
+    bool tooBig = policy_r.maxSize && total > policy_r.maxSize;
+    if ( ! ( tooOld || tooBig ) )
+      break;	// the rest is newer
+
+    bool removed = true;
+    for ( const Pathname & path : unit.paths )
+    {
+      int res = unit.nlink ? filesystem::unlink( path ) : filesystem::recursive_rmdir( path );
+      if ( res != 0 )
+      {
+        WAR << "Can't evict " << path << " (errno " << res << ")" << endl;
+        removed = false;
+      }
+    }
+    if ( ! removed )
+      continue;
+
+    DBG << "Evicted " << unit.paths.front() << " (" << unit.size << ( tooOld ? ", expired" : "" ) << ")" << endl;
+    total -= unit.size;
+    ret.freed += unit.size;
+    if ( unit.nlink )
+      ++ret.packages;
+    else
+      ++ret.metadata;
+  }
+
+  MIL << "Cache eviction (max size " << policy_r.maxSize << ", max age " << policy_r.maxAge << " days): "
+      << ret.size << " in " << units.size() << " units, freed " << ret.freed
+      << " (" << ret.packages << " packages, " << ret.metadata << " raw metadata)" << endl;
+  return ret;
+}
+
+CacheEviction::Policy CacheEviction::configured( Zypper & zypper_r )
+{
+  Policy ret;
+  ret.maxSize = zypper_r.config().commit_cacheMaxSize;
+  ret.maxAge = zypper_r.config().commit_cacheMaxAge;
+  return ret;
+}
+
+bool CacheEviction::parseSize( const std::string & str_r, ByteCount & size_r )
+{
+  const std::string & str { str::trim( str_r ) };
+  std::string::size_type pos = str.find_first_not_of( "0123456789" );
+  if ( str.empty() || pos == 0 )
+    return false;
+
+  std::string unit { pos == std::string::npos ? std::string() : str::toUpper( str::trim( str.substr( pos ) ) ) };
+  if ( str::hasSuffix( unit, "IB" ) )
+    unit.erase( unit.size() - 2 );
+  else if ( unit.size() > 1 && str::hasSuffix( unit, "B" ) )
+    unit.erase( unit.size() - 1 );
+
+  static const std::map<std::string,ByteCount::Unit> units {
+    { "",  ByteCount::B },
+    { "B", ByteCount::B },
+    { "K", ByteCount::K },
+    { "M", ByteCount::M },
+    { "G", ByteCount::G },
+    { "T", ByteCount::T },
+  };
+  auto it = units.find( unit );
+  if ( it == units.end() )
+    return false;
+
+  size_r = ByteCount( str::strtonum<ByteCount::SizeType>( str.substr( 0, pos ) ), it->second );
+  return true;
+}
@@ -0,0 +1,87 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_CACHEEVICTION_H_INCLUDED
+#define ZYPPER_CACHEEVICTION_H_INCLUDED
+
+#include <list>
+#include <set>
+#include <string>
+
+#include <zypp/ByteCount.h>
+#include <zypp/Pathname.h>
+#include <zypp/RepoInfo.h>
+
+class Zypper;
+
+///////////////////////////////////////////////////////////////////
+/// \class CacheEviction
+/// \brief Shrink the package and raw metadata caches to a size budget.
+///
+/// The caches are split into units which are evicted as a whole: each
+/// cached package (all hardlinks to it, incl. the one in the shared
+/// package store) and each repos raw metadata directory. Units not used
+/// for \ref Policy::maxAge days are evicted first, then the least recently
+/// used ones until the caches fit into \ref Policy::maxSize.
+///
+/// A packages last use is its access or modification time, whichever is
+/// newer. Raw metadata counts as used when it was last refreshed. Only raw
+/// metadata of disabled repos and of repos no longer defined is evicted:
+/// libzypp downloads missing raw metadata of an enabled repo whenever it
+/// loads the repo, even without a refresh being due (or \c --no-refresh).
+/// Raw metadata of repos on volatile media (CD/DVD) is never evicted.
+///
+/// The policy for the automatic eviction after each commit is read from
+/// zypper.conf(commit/cacheMaxSize, commit/cacheMaxAge).
+///////////////////////////////////////////////////////////////////
+class CacheEviction
+{
+public:
+  /** What to evict. */
+  struct Policy
+  {
+    zypp::ByteCount maxSize;	///< evict LRU units until the caches fit (0: no limit)
+    unsigned maxAge = 0;	///< evict units not used for more days (0: no limit)
+
+    bool empty() const
+    { return ! maxSize && ! maxAge; }
+  };
+
+  /** What was evicted. */
+  struct Result
+  {
+    zypp::ByteCount size;	///< cache size before eviction
+    zypp::ByteCount freed;	///< bytes freed
+    unsigned packages = 0;	///< number of evicted packages
+    unsigned metadata = 0;	///< number of evicted raw metadata caches
+  };
+
+public:
+  /** Consider all package and raw metadata caches of \a zypper_r. */
+  explicit CacheEviction( Zypper & zypper_r );
+
+  /** Consider only the caches of \a repos_r. */
+  void restrictTo( const std::list<zypp::RepoInfo> & repos_r );
+
+  /** Evict according to \a policy_r. */
+  Result evict( const Policy & policy_r ) const;
+
+  /** The policy configured in zypper.conf. */
+  static Policy configured( Zypper & zypper_r );
+
+  /** Parse a size like \c 500M or \c 2G (units are powers of 1024).
+   * \return \c false if \a str_r is not a valid size.
+   */
+  static bool parseSize( const std::string & str_r, zypp::ByteCount & size_r );
+
+private:
+  std::list<zypp::Pathname> _packageDirs;	///< scanned recursively for packages
+  std::list<zypp::Pathname> _rawDirs;		///< each a raw metadata cache
+  std::set<zypp::Pathname> _keepRaw;		///< raw metadata caches never evicted (enabled and cd/dvd repos)
+};
+
+#endif // ZYPPER_CACHEEVICTION_H_INCLUDED
@@ -23,6 +23,7 @@ extern "C"
 #include "output/OutNormal.h"
 #include "output/OutXML.h"
 #include "Config.h"
+#include "CacheEviction.h"
 #include "global-settings.h"
 #include "Zypper.h"
 
@@ -73,12 +74,21 @@ namespace
   enum class ConfigOption {
     MAIN_SHOW_ALIAS,
     MAIN_REPO_LIST_COLUMNS,
+    MAIN_ADAPTIVE_REFRESH,
+    MAIN_RESUME_REFRESH,
+    MAIN_KEEP_UNCHANGED_SOLV,
+    MAIN_SNAPSHOT_QUERIES,
+    MAIN_PATCH_CHECK_CACHE,
 
     SOLVER_INSTALL_RECOMMENDS,
     SOLVER_FORCE_RESOLUTION_COMMANDS,
 
     COMMIT_AUTO_AGREE_WITH_LICENSES,
     COMMIT_PS_CHECK_ACCESS_DELETED,
+    COMMIT_SHARED_PACKAGE_STORE,
+    COMMIT_PEER_CACHE_URL,
+    COMMIT_CACHE_MAX_SIZE,
+    COMMIT_CACHE_MAX_AGE,
 
     COLOR_USE_COLORS,
     COLOR_RESULT,
@@ -110,11 +120,20 @@ namespace
     static const std::vector<std::pair<std::string,ConfigOption>> _data = {
       { "main/showAlias",			ConfigOption::MAIN_SHOW_ALIAS			},
       { "main/repoListColumns",			ConfigOption::MAIN_REPO_LIST_COLUMNS		},
+      { "main/adaptiveRefresh",			ConfigOption::MAIN_ADAPTIVE_REFRESH		},
+      { "main/resumeRefresh",			ConfigOption::MAIN_RESUME_REFRESH		},
+      { "main/keepUnchangedSolv",		ConfigOption::MAIN_KEEP_UNCHANGED_SOLV		},
+      { "main/snapshotQueries",			ConfigOption::MAIN_SNAPSHOT_QUERIES		},
+      { "main/patchCheckCache",			ConfigOption::MAIN_PATCH_CHECK_CACHE		},
       { "solver/installRecommends",		ConfigOption::SOLVER_INSTALL_RECOMMENDS		},
       { "solver/forceResolutionCommands",	ConfigOption::SOLVER_FORCE_RESOLUTION_COMMANDS	},
 
       { "commit/autoAgreeWithLicenses",		ConfigOption::COMMIT_AUTO_AGREE_WITH_LICENSES	},
       { "commit/psCheckAccessDeleted",		ConfigOption::COMMIT_PS_CHECK_ACCESS_DELETED	},
+      { "commit/sharedPackageStore",		ConfigOption::COMMIT_SHARED_PACKAGE_STORE	},
+      { "commit/peerCacheUrl",			ConfigOption::COMMIT_PEER_CACHE_URL		},
+      { "commit/cacheMaxSize",			ConfigOption::COMMIT_CACHE_MAX_SIZE		},
+      { "commit/cacheMaxAge",			ConfigOption::COMMIT_CACHE_MAX_AGE		},
 
       { "color/useColors",			ConfigOption::COLOR_USE_COLORS			},
       //"color/background"			LEGACY
@@ -188,8 +207,15 @@ namespace
 
 Config::Config()
   : repo_list_columns("anr")
+  , adaptiveRefresh(false)
+  , resumeRefresh(false)
+  , keepUnchangedSolv(false)
+  , snapshotQueries(false)
+  , patchCheckCache(false)
   , solver_installRecommends(!ZConfig::instance().solver_onlyRequires())
   , psCheckAccessDeleted(true)
+  , commit_sharedPackageStore(false)
+  , commit_cacheMaxAge(0)
   , color_useColors	("autodetect")
   , color_pkglistHighlight(true)
   , color_pkglistHighlightAttribute(ansi::Color::nocolor())
@@ -582,6 +608,26 @@ void Config::read( const std::string & file )
     if (!s.empty()) // TODO add some validation
       repo_list_columns = s;
 
+    s = augeas.getOption(asString( ConfigOption::MAIN_ADAPTIVE_REFRESH ));
+    if ( ! s.empty() )
+      adaptiveRefresh = str::strToBool( s, adaptiveRefresh );
+
+    s = augeas.getOption(asString( ConfigOption::MAIN_RESUME_REFRESH ));
+    if ( ! s.empty() )
+      resumeRefresh = str::strToBool( s, resumeRefresh );
+
+    s = augeas.getOption(asString( ConfigOption::MAIN_KEEP_UNCHANGED_SOLV ));
+    if ( ! s.empty() )
+      keepUnchangedSolv = str::strToBool( s, keepUnchangedSolv );
+
+    s = augeas.getOption(asString( ConfigOption::MAIN_SNAPSHOT_QUERIES ));
+    if ( ! s.empty() )
+      snapshotQueries = str::strToBool( s, snapshotQueries );
+
+    s = augeas.getOption(asString( ConfigOption::MAIN_PATCH_CHECK_CACHE ));
+    if ( ! s.empty() )
+      patchCheckCache = str::strToBool( s, patchCheckCache );
+
     // ---------------[ solver ]------------------------------------------------
 
     s = augeas.getOption(asString( ConfigOption::SOLVER_INSTALL_RECOMMENDS ));
@@ -611,6 +657,28 @@ void Config::read( const std::string & file )
     if ( ! s.empty() )
       psCheckAccessDeleted = str::strToBool( s, psCheckAccessDeleted );
 
+    s = augeas.getOption(asString( ConfigOption::COMMIT_SHARED_PACKAGE_STORE ));
+    if ( ! s.empty() )
+      commit_sharedPackageStore = str::strToBool( s, commit_sharedPackageStore );
+
+    s = augeas.getOption(asString( ConfigOption::COMMIT_PEER_CACHE_URL ));
+    if ( ! s.empty() )
+    {
+      try { commit_peerCacheUrl = Url(s); }
+      catch ( Exception & e )
+      {
+        ERR << "Invalid peer cache URL (" << e.msg() << "), peer cache disabled." << endl;
+      }
+    }
+
+    s = augeas.getOption(asString( ConfigOption::COMMIT_CACHE_MAX_SIZE ));
+    if ( ! s.empty() && ! CacheEviction::parseSize( s, commit_cacheMaxSize ) )
+      WAR << "Ignoring invalid commit/cacheMaxSize '" << s << "'" << endl;
+
+    s = augeas.getOption(asString( ConfigOption::COMMIT_CACHE_MAX_AGE ));
+    if ( ! s.empty() )
+      commit_cacheMaxAge = str::strtonum<unsigned>( s );
+
     // ---------------[ colors ]------------------------------------------------
 
     s = augeas.getOption( asString( ConfigOption::COLOR_USE_COLORS ) );
@@ -12,6 +12,7 @@
 #include <set>
 
 #include <zypp/Url.h>
+#include <zypp/ByteCount.h>
 #include <zypp/Pathname.h>
 #include <zypp/RepoManager.h>
 
@@ -38,10 +39,20 @@ struct Config : public ztui::Config
   /** Which columns to show in repo list by default (string of short options).*/
   std::string repo_list_columns;
 
+  bool adaptiveRefresh;	///< let the \ref RefreshSchedule decide when autorefresh checks a repo?
+  bool resumeRefresh;	///< keep completed raw metadata files of an interrupted refresh (\ref MetadataCheckpoint)?
+  bool keepUnchangedSolv;	///< don't rebuild solv files if the data they are built from did not change (\ref SolvFingerprint)?
+  bool snapshotQueries;	///< let read-only queries run without the zypp lock if it is held by another process?
+  bool patchCheckCache;	///< remember the patch-check verdict for unchanged input?
+
   bool solver_installRecommends;
   std::set<ZypperCommand> solver_forceResolutionCommands;
 
   bool psCheckAccessDeleted;	///< do post commit 'zypper ps' check?
+  bool commit_sharedPackageStore;	///< use the content-addressed package store shared by all repos?
+  zypp::Url commit_peerCacheUrl;	///< try to get packages from this peer cache before downloading them (empty: disabled)
+  zypp::ByteCount commit_cacheMaxSize;	///< evict LRU cached packages and raw metadata after commit to fit into this (0: no limit)
+  unsigned commit_cacheMaxAge;	///< evict cached packages and raw metadata not used for more days after commit (0: no limit)
 
   /** zypper.conf: color.useColors */
   std::string color_useColors;
@@ -0,0 +1,141 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <fstream>
+#include <list>
+#include <set>
+
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/base/UserRequestException.h>
+#include <zypp/PathInfo.h>
+#include <zypp/MediaSetAccess.h>
+#include <zypp/OnMediaLocation.h>
+#include <zypp/parser/yum/RepomdFileReader.h>
+
+#include "main.h"
+#include "Zypper.h"
+#include "MetadataCheckpoint.h"
+#include "utils/misc.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  /** The list of files stored by \ref MetadataCheckpoint::fetch (dropped with the raw dir by a successful refresh). */
+  inline Pathname checkpointList( const Pathname & rawdir_r )
+  { return rawdir_r / ".zypper-checkpoint"; }
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+MetadataCheckpoint::MetadataCheckpoint( Zypper & zypper_r, const RepoInfo & repo_r )
+: _zypper( zypper_r )
+, _repo( repo_r )
+{}
+
+bool MetadataCheckpoint::enabled( Zypper & zypper_r )
+{ return zypper_r.config().resumeRefresh; }
+
+bool MetadataCheckpoint::applicable() const
+{
+  return _repo.type() == repo::RepoType::RPMMD
+      && ! _repo.baseUrlsEmpty() && _repo.url().schemeIsDownloading()
+      && ! _repo.metadataPath().empty();
+}
+
+bool MetadataCheckpoint::fetch()
+{
+  const Pathname & rawdir { _repo.metadataPath() };
+  std::set<Pathname> stored;
+  {
+    std::ifstream in( checkpointList( rawdir ).c_str() );
+    std::string line;
+    while ( std::getline( in, line ) )
+      stored.insert( line );
+  }
+
+  std::list<OnMediaLocation> todo;
+  try
+  {
+    MediaSetAccess media( _repo.url() );
+    const Pathname & repomd { media.provideFile( OnMediaLocation( _repo.path() / "repodata/repomd.xml" ), MediaSetAccess::PROVIDE_NON_INTERACTIVE ) };
+
+    parser::yum::RepomdFileReader( repomd, [&]( auto && loc_r, auto && type_r ) -> bool {
+      const std::string & type { str::asString( type_r ) };
+      if ( ! isDownloadedRepomdType( type ) || loc_r.checksum().empty() )
+        return true;
+
+      ++_stats.files;
+      _stats.size += loc_r.downloadSize();
+      const Pathname & target { rawdir / loc_r.filename() };
+      PathInfo pi( target );
+      if ( pi.isExist() )
+      {
+        if ( fileMatchesChecksum( target, loc_r.checksum() ) )
+        {
+          ++_stats.done;
+          if ( stored.count( loc_r.filename() ) )
+            _stats.resumed += pi.size();
+        }
+        // else: a cached file of the same name; libzypp will replace it.
+        return true;
+      }
+      todo.push_back( loc_r );
+      return true;
+    } );
+
+    if ( _stats.resumed )
+      _zypper.out().info( str::Format(_("Resuming metadata download of '%1%': %2% of %3% already retrieved."))
+                          % _repo.asUserString() % _stats.resumed % _stats.size );
+
+    filesystem::assert_dir( rawdir );
+    std::ofstream list( checkpointList( rawdir ).c_str(), std::ios_base::app );
+    for ( const OnMediaLocation & loc : todo )
+    {
+      OnMediaLocation remote( _repo.path() / loc.filename() );
+      remote.setChecksum( loc.checksum() );
+      remote.setDownloadSize( loc.downloadSize() );
+      const Pathname & local { media.provideFile( remote, MediaSetAccess::PROVIDE_NON_INTERACTIVE ) };
+      if ( ! fileMatchesChecksum( local, loc.checksum() ) )
+      {
+        WAR << "Checksum mismatch for " << loc.filename() << " of " << _repo.alias() << ", left to libzypp." << endl;
+        continue;
+      }
+
+      const Pathname & target { rawdir / loc.filename() };
+      const Pathname & tmp { target.extend( ".part" ) };
+      filesystem::assert_dir( target.dirname() );
+      if ( filesystem::hardlinkCopy( local, tmp ) != 0 || filesystem::rename( tmp, target ) != 0 )
+      {
+        ERR << "Can't store " << local << " as " << target << endl;
+        filesystem::unlink( tmp );
+        break;	// most probably a full disk
+      }
+      ++_stats.done;
+      list << loc.filename() << endl;
+      DBG << "Checkpoint " << target << endl;
+    }
+  }
+  catch ( const AbortRequestException & e )
+  {
+    ZYPP_CAUGHT( e );
+    ZYPP_RETHROW( e );	// the user wants to stop
+  }
+  catch ( const Exception & e )
+  {
+    ZYPP_CAUGHT( e );
+    if ( _stats.files )
+      _zypper.out().info( str::Format(_("Retrieved %1% of %2% metadata files of '%3%'. An interrupted refresh resumes from here."))
+                          % _stats.done % _stats.files % _repo.asUserString(), Out::HIGH );
+  }
+
+  MIL << _repo.alias() << ": " << _stats.done << " of " << _stats.files << " metadata files available ("
+      << _stats.resumed << " of " << _stats.size << " resumed)" << endl;
+  return _stats.files && _stats.done == _stats.files;
+}
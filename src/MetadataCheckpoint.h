@@ -0,0 +1,74 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_METADATACHECKPOINT_H_INCLUDED
+#define ZYPPER_METADATACHECKPOINT_H_INCLUDED
+
+#include <zypp/ByteCount.h>
+#include <zypp/RepoInfo.h>
+
+class Zypper;
+
+///////////////////////////////////////////////////////////////////
+/// \class MetadataCheckpoint
+/// \brief Download a repos raw metadata file by file, keeping what was completed.
+///
+/// libzypp downloads the raw metadata into a temporary directory which is
+/// discarded if the refresh fails, so a refresh interrupted in the middle of
+/// a large primary or filelists file starts from zero next time. But libzypp
+/// copies files whose checksum matches the one in the new repomd.xml from the
+/// existing raw metadata instead of downloading them again.
+///
+/// Before libzypp refreshes a rpm-md repo, \ref fetch downloads the files
+/// of the remote repomd.xml libzypp would download (see \ref
+/// isDownloadedRepomdType) one by one into the repos raw metadata directory,
+/// skipping files already there with matching checksum. Each file is
+/// verified before it is stored. If the download fails, the files
+/// completed so far stay and are reused by the next attempt. The checkpoint
+/// files do not interfere with the cached metadata (a file having the name of
+/// a cached file is left to libzypp) and are dropped by the next successful
+/// refresh.
+///
+/// Enabled via zypper.conf(main/resumeRefresh).
+///////////////////////////////////////////////////////////////////
+class MetadataCheckpoint
+{
+public:
+  /** What \ref fetch did. */
+  struct Stats
+  {
+    unsigned files = 0;		///< files listed in repomd.xml
+    unsigned done = 0;		///< files now in the raw metadata dir
+    zypp::ByteCount size;	///< total size of the listed files (as far as known)
+    zypp::ByteCount resumed;	///< size of the files kept from an interrupted refresh
+  };
+
+public:
+  MetadataCheckpoint( Zypper & zypper_r, const zypp::RepoInfo & repo_r );
+
+  /** Whether zypper.conf enables checkpointing. */
+  static bool enabled( Zypper & zypper_r );
+
+  /** Whether checkpointing applies to the repo (remote rpm-md). */
+  bool applicable() const;
+
+  /** Download the missing metadata files.
+   * \return Whether all files are available now. A failing download is
+   * not reported as an error; libzypp will try (and report) on its own.
+   */
+  bool fetch();
+
+  const Stats & stats() const
+  { return _stats; }
+
+private:
+  Zypper & _zypper;
+  zypp::RepoInfo _repo;
+  Stats _stats;
+};
+
+#endif // ZYPPER_METADATACHECKPOINT_H_INCLUDED
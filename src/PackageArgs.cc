@@ -10,7 +10,10 @@
  */
 
 #include <iostream>
+#include <fstream>
+#include <unordered_map>
 #include <zypp/base/Logger.h>
+#include <zypp/base/IOStream.h>
 
 #include "PackageArgs.h"
 #include "Zypper.h"
@@ -26,6 +29,32 @@ PackageArgs::PackageArgs( const std::vector<std::string> & args, const ResKind &
 
 // ---------------------------------------------------------------------------
 
+std::vector<std::string> PackageArgs::readArgsFile( const Pathname & file_r )
+{
+  std::ifstream infile;
+  if ( file_r != "-" )
+  {
+    infile.open( file_r.c_str() );
+    if ( ! infile )
+      ZYPP_THROW( Exception( ( str::Format(_("Can't read %1%")) % file_r ).str() ) );
+  }
+  std::istream & in { file_r == "-" ? std::cin : infile };
+
+  std::vector<std::string> ret;
+  for ( iostr::EachLine line( in ); line; line.next() )
+  {
+    std::string l { *line };
+    std::string::size_type pos = l.find( '#' );
+    if ( pos != std::string::npos )
+      l.erase( pos );
+    str::split( l, std::back_inserter(ret) );
+  }
+  MIL << "Read " << ret.size() << " args from " << file_r << endl;
+  return ret;
+}
+
+// ---------------------------------------------------------------------------
+
 void PackageArgs::preprocess( const std::vector<std::string> & args )
 {
   // Preprocess asserts not to store empty strings in _args !
@@ -109,6 +138,17 @@ static bool remove_duplicate( PackageArgs::PackageSpecSet & set, const PackageSp
 
 void PackageArgs::argsToCaps( const ResKind & kind )
 {
+  // Long argument lists often share the same 'repo:' or 'kind:' prefix.
+  // Remember whether it names a repo, as match_repo may do an expensive
+  // URL analysis for each call.
+  std::unordered_map<std::string,bool> knownRepos;
+  auto isRepo = [&]( const std::string & repo_r )->bool {
+    auto it = knownRepos.find( repo_r );
+    if ( it == knownRepos.end() )
+      it = knownRepos.emplace( repo_r, match_repo( zypper, repo_r ) ).first;
+    return it->second;
+  };
+
   bool dont;
   std::string arg, repo;
   for_( it, _args.begin(), _args.end() )
@@ -188,7 +228,7 @@ void PackageArgs::argsToCaps( const ResKind & kind )
     {
       repo = arg.substr( 0, pos );
 
-      if ( match_repo( zypper, repo ) )
+      if ( isRepo( repo ) )
       {
         hasRepo = true;
         arg = arg.substr( pos + 1 );
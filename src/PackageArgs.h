@@ -19,6 +19,7 @@
 #include <iosfwd>
 
 #include <zypp/Capability.h>
+#include <zypp/Pathname.h>
 using namespace zypp;
 
 class Zypper;
@@ -68,6 +69,12 @@ public:
 
   ~PackageArgs() {}
 
+  /** Read package arguments from \a file_r (\c - for stdin).
+   * Arguments are separated by whitespace, \c # starts a comment.
+   * \throws zypp::Exception if \a file_r can't be read.
+   */
+  static std::vector<std::string> readArgsFile( const Pathname & file_r );
+
   const Options & options() const
   { return _opts; }
 
@@ -0,0 +1,133 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <iostream>
+
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/PathInfo.h>
+#include <zypp/OnMediaLocation.h>
+#include <zypp/Package.h>
+#include <zypp/SrcPackage.h>
+
+#include "Zypper.h"
+#include "PackageStore.h"
+#include "utils/misc.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  inline bool isPackageType( const sat::Solvable & slv_r )
+  { return( slv_r.isKind<Package>() || slv_r.isKind<SrcPackage>() ); }
+
+  /** The location of \a slv_r in its repos package cache (the same libzypp's cachedLocation() checks). */
+  inline Pathname cacheLocation( const sat::Solvable & slv_r, const OnMediaLocation & loc_r )
+  {
+    const RepoInfo & info { slv_r.repository().info() };
+    return info.packagesPath() / info.path() / loc_r.filename();
+  }
+
+  inline bool isInstallStep( const sat::Transaction::Step & step_r )
+  { return step_r.stepType() == sat::Transaction::TRANSACTION_INSTALL || step_r.stepType() == sat::Transaction::TRANSACTION_MULTIINSTALL; }
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+PackageStore::PackageStore( Zypper & zypper_r )
+: _root( Pathname::assertprefix( zypper_r.config().root_dir, zypper_r.config().rm_options.repoPackagesCachePath ) / "@Store" )
+{}
+
+PackageStore::PackageStore( Pathname root_r )
+: _root( std::move(root_r) )
+{}
+
+bool PackageStore::enabled( Zypper & zypper_r )
+{ return zypper_r.config().commit_sharedPackageStore; }
+
+Pathname PackageStore::storeLocation( const CheckSum & checksum_r ) const
+{
+  if ( checksum_r.empty() )
+    return Pathname();
+  const std::string & sum { checksum_r.checksum() };
+  return _root / checksum_r.type() / sum.substr( 0, 2 ) / sum;
+}
+
+bool PackageStore::adopt( const sat::Solvable & slv_r ) const
+{
+  TriBool ret { doAdopt( slv_r ) };
+  return indeterminate( ret ) || bool(ret);
+}
+
+TriBool PackageStore::doAdopt( const sat::Solvable & slv_r ) const
+{
+  if ( ! isPackageType( slv_r ) || slv_r.isSystem() )
+    return false;
+
+  const OnMediaLocation & loc { slv_r.lookupLocation() };
+  const Pathname & cached { cacheLocation( slv_r, loc ) };
+  if ( fileMatchesChecksum( cached, loc.checksum() ) )
+    return indeterminate;	// already in the repos package cache
+
+  const Pathname & stored { storeLocation( loc.checksum() ) };
+  if ( stored.empty() || ! PathInfo( stored ).isFile() )
+    return false;
+
+  if ( ! fileMatchesChecksum( stored, loc.checksum() ) )
+  {
+    WAR << "Remove corrupted store file " << stored << endl;
+    filesystem::unlink( stored );
+    return false;
+  }
+
+  filesystem::assert_dir( cached.dirname() );
+  filesystem::unlink( cached );	// a stale or broken file may block the link
+  if ( filesystem::hardlinkCopy( stored, cached ) != 0 )
+  {
+    ERR << "Can't hardlink/copy " << stored << " to " << cached << endl;
+    return false;
+  }
+  DBG << "Adopted " << slv_r << " from " << stored << endl;
+  return true;
+}
+
+bool PackageStore::harvest( const sat::Solvable & slv_r ) const
+{
+  if ( ! isPackageType( slv_r ) || slv_r.isSystem() )
+    return false;
+
+  const OnMediaLocation & loc { slv_r.lookupLocation() };
+  const Pathname & stored { storeLocation( loc.checksum() ) };
+  if ( stored.empty() || PathInfo( stored ).isExist() )
+    return false;
+
+  const Pathname & cached { cacheLocation( slv_r, loc ) };
+  if ( ! fileMatchesChecksum( cached, loc.checksum() ) )
+    return false;
+
+  filesystem::assert_dir( stored.dirname() );
+  if ( filesystem::hardlinkCopy( cached, stored ) != 0 )
+  {
+    ERR << "Can't hardlink/copy " << cached << " to " << stored << endl;
+    return false;
+  }
+  DBG << "Stored " << slv_r << " as " << stored << endl;
+  return true;
+}
+
+unsigned PackageStore::adoptTransaction( const sat::Transaction & trans_r ) const
+{
+  unsigned ret = 0;
+  for ( const sat::Transaction::Step & step : trans_r )
+  {
+    if ( isInstallStep( step ) && doAdopt( step.satSolvable() ) == true )
+      ++ret;
+  }
+  MIL << "Adopted " << ret << " packages from " << _root << endl;
+  return ret;
+}
@@ -0,0 +1,78 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_PACKAGESTORE_H_INCLUDED
+#define ZYPPER_PACKAGESTORE_H_INCLUDED
+
+#include <zypp/TriBool.h>
+#include <zypp/Pathname.h>
+#include <zypp/CheckSum.h>
+#include <zypp/sat/Solvable.h>
+#include <zypp/sat/Transaction.h>
+
+class Zypper;
+
+///////////////////////////////////////////////////////////////////
+/// \class PackageStore
+/// \brief Content-addressed package store shared by all repos package caches.
+///
+/// Each package is stored once below \c <pkg-cache-dir>/@Store/<type>/<xx>/<checksum>
+/// and hardlinked into the package cache directories of the repos providing
+/// it. Before a package is downloaded, a stored copy with matching checksum is
+/// linked into the repos package cache, so libzypp will find it cached.
+/// Packages are stored as soon as their download finished (see the
+/// DownloadResolvableReportReceiver), before libzypp removes them from the
+/// cache of a repo without keeppackages.
+///
+/// The store is enabled via zypper.conf(commit/sharedPackageStore).
+///
+/// \note Stored files are verified against the packages checksum before they
+/// are used. Corrupted files are removed from the store.
+///////////////////////////////////////////////////////////////////
+class PackageStore
+{
+public:
+  /** Store below the package cache directory of \a zypper_r. */
+  explicit PackageStore( Zypper & zypper_r );
+
+  /** Store in \a root_r. */
+  explicit PackageStore( zypp::Pathname root_r );
+
+  /** Whether the store is enabled in zypper.conf. */
+  static bool enabled( Zypper & zypper_r );
+
+  /** The store root directory. */
+  const zypp::Pathname & root() const
+  { return _root; }
+
+  /** Path of a file with checksum \a checksum_r within the store (empty if \a checksum_r is empty). */
+  zypp::Pathname storeLocation( const zypp::CheckSum & checksum_r ) const;
+
+  /** Provide \a slv_r in its repos package cache from the store.
+   * \return Whether the package is now available in the repos package cache.
+   */
+  bool adopt( const zypp::sat::Solvable & slv_r ) const;
+
+  /** Remember the cached copy of \a slv_r in the store.
+   * \return Whether the package was newly added to the store.
+   */
+  bool harvest( const zypp::sat::Solvable & slv_r ) const;
+
+  /** \ref adopt all packages to be installed by \a trans_r.
+   * \return The number of packages provided from the store.
+   */
+  unsigned adoptTransaction( const zypp::sat::Transaction & trans_r ) const;
+
+private:
+  /** \ref adopt, but \c indeterminate if the package was already cached. */
+  zypp::TriBool doAdopt( const zypp::sat::Solvable & slv_r ) const;
+
+private:
+  zypp::Pathname _root;
+};
+
+#endif // ZYPPER_PACKAGESTORE_H_INCLUDED
@@ -0,0 +1,54 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <zypp/base/Logger.h>
+#include <zypp/ResPool.h>
+
+#include "PatchTable.h"
+
+using namespace zypp;
+
+const PatchTable & PatchTable::instance()
+{
+  static PatchTable _table;
+  if ( _table._watcher.remember( ResPool::instance().serial() ) )
+    _table.build();
+  return _table;
+}
+
+void PatchTable::build()
+{
+  _entries.clear();
+
+  const ResPool & pool { ResPool::instance() };
+  for ( const PoolItem & pi : pool.byKind( ResKind::patch ) )
+  {
+    Entry entry;
+    entry.item = pi;
+    entry.patch = asKind<Patch>( pi );
+    if ( ! entry.patch )
+      continue;
+
+    entry.category = entry.patch->categoryEnum();
+    if ( entry.patch->restartSuggested() )
+      entry.bits |= Entry::kRestart;
+
+    _entries.push_back( std::move(entry) );
+  }
+  _entries.shrink_to_fit();
+  MIL << "Patch table: " << _entries.size() << " patches" << endl;
+}
+
+bool PatchTable::anyNeededRestartSuggested( bool excludeOptional_r ) const
+{
+  for ( const Entry & entry : _entries )
+  {
+    if ( entry.neededRestartSuggested( excludeOptional_r ) )
+      return true;
+  }
+  return false;
+}
@@ -0,0 +1,86 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_PATCHTABLE_H_INCLUDED
+#define ZYPPER_PATCHTABLE_H_INCLUDED
+
+#include <cstdint>
+#include <vector>
+
+#include <zypp/base/SerialNumber.h>
+#include <zypp/Patch.h>
+#include <zypp/PoolItem.h>
+
+///////////////////////////////////////////////////////////////////
+/// \class PatchTable
+/// \brief The patches in the pool and their precomputed attributes.
+///
+/// The patch category and the restart flag are looked up once and kept
+/// in a contiguous array, so the various patch lists, \c patch-check and
+/// the \c patch command don't need to query the patch data for each patch
+/// again and again (e.g. in the zypper shell).
+///
+/// The table is rebuilt as soon as the pool content changes. The patch
+/// status (needed, unwanted) is not part of it: it is established
+/// anew by each resolver run and depends on the locks, so \ref Entry reads
+/// it from the PoolItem whenever asked.
+///
+/// \code
+///   for ( const PatchTable::Entry & entry : PatchTable::instance() )
+///     if ( entry.applicable() )
+///       ...
+/// \endcode
+///////////////////////////////////////////////////////////////////
+class PatchTable
+{
+public:
+  struct Entry
+  {
+    enum Bit : uint8_t
+    {
+      kRestart		= 1<<0,	///< affects the package manager
+    };
+
+    zypp::PoolItem item;
+    zypp::Patch::constPtr patch;
+    zypp::Patch::Category category = zypp::Patch::CAT_OTHER;
+    uint8_t bits = 0;
+
+    /** Default content for all patch lists: applicable (needed, optional, unwanted) */
+    bool applicable() const		{ return item.isBroken(); }
+    bool unwanted() const		{ return item.isBroken() && item.isUnwanted(); }
+    bool restartSuggested() const	{ return bits & kRestart; }
+    bool optional() const		{ return category == zypp::Patch::CAT_OPTIONAL; }
+
+    /** Needed update stack patch; installed first! */
+    bool neededRestartSuggested( bool excludeOptional_r ) const
+    { return applicable() && ! unwanted() && ! ( excludeOptional_r && optional() ) && restartSuggested(); }
+  };
+
+  typedef std::vector<Entry>::const_iterator const_iterator;
+
+public:
+  /** The table for the current pool (rebuilt if the pool content changed). */
+  static const PatchTable & instance();
+
+  /** Whether any needed patch affects the package manager. */
+  bool anyNeededRestartSuggested( bool excludeOptional_r ) const;
+
+public:
+  bool empty() const			{ return _entries.empty(); }
+  size_t size() const			{ return _entries.size(); }
+  const_iterator begin() const		{ return _entries.begin(); }
+  const_iterator end() const		{ return _entries.end(); }
+
+private:
+  void build();
+
+  std::vector<Entry> _entries;
+  zypp::SerialNumberWatcher _watcher;
+};
+
+#endif // ZYPPER_PATCHTABLE_H_INCLUDED
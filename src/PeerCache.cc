@@ -0,0 +1,157 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <zypp/base/Logger.h>
+#include <zypp/AutoDispose.h>
+#include <zypp/PathInfo.h>
+#include <zypp/OnMediaLocation.h>
+#include <zypp/Package.h>
+#include <zypp/SrcPackage.h>
+#include <zypp/media/MediaManager.h>
+#include <zypp/media/MediaException.h>
+
+#include "Zypper.h"
+#include "PackageStore.h"
+#include "PeerCache.h"
+#include "utils/misc.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  inline bool isPackageType( const sat::Solvable & slv_r )
+  { return( slv_r.isKind<Package>() || slv_r.isKind<SrcPackage>() ); }
+
+  /** The location of \a slv_r in its repos package cache (the same libzypp's cachedLocation() checks). */
+  inline Pathname cacheLocation( const sat::Solvable & slv_r, const OnMediaLocation & loc_r )
+  {
+    const RepoInfo & info { slv_r.repository().info() };
+    return info.packagesPath() / info.path() / loc_r.filename();
+  }
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+/** The attached peer. */
+struct PeerCache::Media
+{
+  explicit Media( const Url & url_r )
+  : _mid { _mm.open( url_r ) }
+  {
+    media::MediaManager & mm { _mm };
+    _mid.setDispose( [&mm]( media::MediaAccessId mid ){ mm.release( mid ); mm.close( mid ); } );
+    _mm.attach( _mid );
+  }
+
+  media::MediaManager _mm;
+  AutoDispose<media::MediaAccessId> _mid;
+};
+
+PeerCache::PeerCache( Zypper & zypper_r )
+: PeerCache( zypper_r.config().commit_peerCacheUrl )
+{}
+
+PeerCache::PeerCache( Url url_r )
+: _url( std::move(url_r) )
+{}
+
+PeerCache::~PeerCache()
+{}
+
+bool PeerCache::enabled( Zypper & zypper_r )
+{ return zypper_r.config().commit_peerCacheUrl.isValid(); }
+
+bool PeerCache::fetch( const sat::Solvable & slv_r )
+{
+  if ( _unreachable || ! isPackageType( slv_r ) || slv_r.isSystem() )
+    return false;
+
+  const OnMediaLocation & loc { slv_r.lookupLocation() };
+  if ( loc.checksum().empty() )
+    return false;	// can't verify what the peer sends
+
+  const Pathname & cached { cacheLocation( slv_r, loc ) };
+  if ( fileMatchesChecksum( cached, loc.checksum() ) )
+    return false;	// already in the repos package cache
+
+  const RepoInfo & info { slv_r.repository().info() };
+  std::list<Pathname> paths {
+    PackageStore( Pathname("/@Store") ).storeLocation( loc.checksum() ),
+    Pathname("/") / info.alias() / info.path() / loc.filename(),
+  };
+  return doFetch( slv_r, paths, cached );
+}
+
+bool PeerCache::doFetch( const sat::Solvable & slv_r, const std::list<Pathname> & paths_r, const Pathname & target_r )
+{
+  const CheckSum & checksum { slv_r.lookupLocation().checksum() };
+  try
+  {
+    if ( ! _media )
+      _media.reset( new Media( _url ) );
+    media::MediaManager & mm { _media->_mm };
+
+    for ( const Pathname & path : paths_r )
+    {
+      try
+      {
+        mm.provideFile( _media->_mid, path );
+      }
+      catch ( const media::MediaFileNotFoundException & e )
+      {
+        ZYPP_CAUGHT( e );
+        continue;
+      }
+
+      const Pathname & local { mm.localPath( _media->_mid, path ) };
+      bool ok = fileMatchesChecksum( local, checksum );
+      if ( ok )
+      {
+        filesystem::assert_dir( target_r.dirname() );
+        filesystem::unlink( target_r );	// a stale or broken file may block the copy
+        if ( filesystem::hardlinkCopy( local, target_r ) != 0 )
+        {
+          ERR << "Can't hardlink/copy " << local << " to " << target_r << endl;
+          ok = false;
+        }
+      }
+      else
+        WAR << "Peer file " << _url << path << " does not match " << checksum << endl;
+
+      mm.releaseFile( _media->_mid, path );
+      if ( ok )
+      {
+        DBG << "Fetched " << slv_r << " from " << _url << path << endl;
+        return true;
+      }
+    }
+  }
+  catch ( const Exception & e )
+  {
+    ZYPP_CAUGHT( e );
+    WAR << "Peer cache " << _url << " unreachable, not asking it again." << endl;
+    _unreachable = true;
+    _media.reset();
+  }
+  return false;
+}
+
+unsigned PeerCache::fetchTransaction( const sat::Transaction & trans_r )
+{
+  unsigned ret = 0;
+  for ( const sat::Transaction::Step & step : trans_r )
+  {
+    if ( _unreachable )
+      break;
+    if ( ( step.stepType() == sat::Transaction::TRANSACTION_INSTALL || step.stepType() == sat::Transaction::TRANSACTION_MULTIINSTALL )
+         && fetch( step.satSolvable() ) )
+      ++ret;
+  }
+  MIL << "Fetched " << ret << " packages from peer cache " << _url << endl;
+  return ret;
+}
@@ -0,0 +1,73 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_PEERCACHE_H_INCLUDED
+#define ZYPPER_PEERCACHE_H_INCLUDED
+
+#include <list>
+
+#include <zypp/base/PtrTypes.h>
+#include <zypp/Pathname.h>
+#include <zypp/Url.h>
+#include <zypp/sat/Solvable.h>
+#include <zypp/sat/Transaction.h>
+
+class Zypper;
+
+///////////////////////////////////////////////////////////////////
+/// \class PeerCache
+/// \brief Get packages from the package cache of a peer host before downloading them.
+///
+/// The peer is any HTTP (or other libzypp supported) server exporting the
+/// peers package cache directory (\c /var/cache/zypp/packages). A package
+/// is looked up by its checksum in the peers shared package store
+/// (\c @Store/<type>/<xx>/<checksum>, see \ref PackageStore) and then by
+/// repo alias in the peers repo package cache (\c <alias>/<path>). A copy is
+/// used only if it matches the packages checksum; packages without checksum
+/// are never taken from a peer.
+///
+/// If the peer is unreachable, it's not asked again during this run. Any
+/// package not found at the peer is downloaded from the repo as usual.
+///
+/// The peer is configured via zypper.conf(commit/peerCacheUrl).
+///////////////////////////////////////////////////////////////////
+class PeerCache
+{
+public:
+  /** Use the peer cache configured for \a zypper_r. */
+  explicit PeerCache( Zypper & zypper_r );
+
+  /** Use the peer cache at \a url_r. */
+  explicit PeerCache( zypp::Url url_r );
+
+  ~PeerCache();
+
+  /** Whether a peer cache is configured in zypper.conf. */
+  static bool enabled( Zypper & zypper_r );
+
+  /** Provide \a slv_r in its repos package cache from the peer.
+   * \return Whether the package was fetched from the peer.
+   */
+  bool fetch( const zypp::sat::Solvable & slv_r );
+
+  /** \ref fetch all packages to be installed by \a trans_r which are not yet cached.
+   * \return The number of packages provided by the peer.
+   */
+  unsigned fetchTransaction( const zypp::sat::Transaction & trans_r );
+
+private:
+  struct Media;
+  /** Try the peer locations of \a slv_r in turn. */
+  bool doFetch( const zypp::sat::Solvable & slv_r, const std::list<zypp::Pathname> & paths_r, const zypp::Pathname & target_r );
+
+private:
+  zypp::Url _url;
+  zypp::shared_ptr<Media> _media;	///< attached on first use
+  bool _unreachable = false;
+};
+
+#endif // ZYPPER_PEERCACHE_H_INCLUDED
@@ -0,0 +1,167 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/PathInfo.h>
+#include <zypp/ZConfig.h>
+
+#include "Zypper.h"
+#include "commands/repos/refresh.h"
+#include "RefreshSchedule.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  const Date::Duration maxInterval = 7 * Date::day;
+
+  /** Checks needed before the observed change frequency is trusted. */
+  const unsigned minChecks = 3;
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+RefreshSchedule & RefreshSchedule::instance( Zypper & zypper_r )
+{
+  const Config & config { zypper_r.config() };
+  static RefreshSchedule _instance( Pathname::assertprefix( config.root_dir, config.rm_options.repoCachePath ) / "zypper" / "refresh-schedule" );
+  return _instance;
+}
+
+bool RefreshSchedule::enabled( Zypper & zypper_r )
+{ return zypper_r.config().adaptiveRefresh; }
+
+RefreshSchedule::RefreshSchedule( Pathname file_r )
+: _file( std::move(file_r) )
+{
+  std::ifstream in( _file.c_str() );
+  std::string line;
+  while ( std::getline( in, line ) )
+  {
+    if ( line.empty() || line[0] == '#' )
+      continue;
+
+    std::istringstream fields( line );
+    Date::ValueType firstCheck = 0, lastCheck = 0, lastChange = 0, expires = 0;
+    Entry entry;
+    std::string alias;
+    if ( ! ( fields >> firstCheck >> lastCheck >> lastChange >> entry.checks >> entry.changes >> expires )
+         || ! std::getline( fields, alias ) || str::trim( alias ).empty() )
+    {
+      WAR << "Ignoring malformed line in " << _file << ": " << line << endl;
+      continue;
+    }
+    entry.firstCheck = firstCheck;
+    entry.lastCheck = lastCheck;
+    entry.lastChange = lastChange;
+    entry.expires = expires;
+    _entries[str::trim( alias )] = entry;
+  }
+  DBG << "Read the refresh history of " << _entries.size() << " repos from " << _file << endl;
+}
+
+Date::Duration RefreshSchedule::interval( const RepoInfo & repo_r ) const
+{
+  Date::Duration base = Date::Duration(ZConfig::instance().repo_refresh_delay()) * Date::minute;
+  if ( RefreshRepoCmd::isUpdateRepo( repo_r ) )
+    return base;
+
+  auto it = _entries.find( repo_r.alias() );
+  if ( it == _entries.end() || it->second.checks < minChecks )
+    return base;
+
+  // Checking at half the average time between changes catches most changes
+  // early enough. A repo never seen changing counts as changing once.
+  const Entry & entry { it->second };
+  Date::Duration observed = ( entry.lastCheck - entry.firstCheck ) / ( entry.changes + 1 );
+  return std::max( base, std::min( observed / 2, maxInterval ) );
+}
+
+bool RefreshSchedule::due( const RepoInfo & repo_r, Date now_r ) const
+{
+  auto it = _entries.find( repo_r.alias() );
+  if ( it == _entries.end() || RefreshRepoCmd::isUpdateRepo( repo_r ) )
+    return true;	// libzypp's repo.refresh.delay still applies
+
+  const Entry & entry { it->second };
+  if ( now_r < entry.lastCheck )
+    return true;	// clock went backwards
+  if ( now_r - entry.lastCheck >= maxInterval )
+    return true;
+  if ( entry.expires )
+    return now_r >= entry.expires;
+  return now_r - entry.lastCheck >= interval( repo_r );
+}
+
+void RefreshSchedule::checked( const RepoInfo & repo_r, bool changed_r, Date now_r )
+{
+  Entry & entry { _entries[repo_r.alias()] };
+  if ( ! entry.checks )
+  {
+    entry.firstCheck = now_r;
+    changed_r = false;	// the initial download is no change
+  }
+  entry.lastCheck = now_r;
+  ++entry.checks;
+  if ( changed_r )
+  {
+    entry.lastChange = now_r;
+    ++entry.changes;
+    entry.expires = Date();	// known when the new metadata are loaded
+  }
+  _dirty = true;
+  DBG << repo_r.alias() << " checked" << ( changed_r ? ", changed" : "" ) << " (" << entry.changes << "/" << entry.checks << ")" << endl;
+}
+
+void RefreshSchedule::expires( const RepoInfo & repo_r, Date expires_r )
+{
+  auto it = _entries.find( repo_r.alias() );
+  if ( it == _entries.end() || it->second.expires == expires_r )
+    return;	// only for repos we saw being checked
+  it->second.expires = expires_r;
+  _dirty = true;
+}
+
+void RefreshSchedule::save()
+{
+  if ( ! _dirty )
+    return;
+  if ( Zypper::instance().runtimeData().snapshot_read )
+    return;	// no cache writes without the zypp lock
+
+  filesystem::assert_dir( _file.dirname() );
+  Pathname tmp { _file.extend( ".new" ) };
+  {
+    std::ofstream out( tmp.c_str() );
+    out << "# first-check last-check last-change checks changes expires alias" << endl;
+    for ( const auto & el : _entries )
+    {
+      const Entry & entry { el.second };
+      out << Date::ValueType(entry.firstCheck) << " " << Date::ValueType(entry.lastCheck) << " " << Date::ValueType(entry.lastChange)
+          << " " << entry.checks << " " << entry.changes << " " << Date::ValueType(entry.expires) << " " << el.first << endl;
+    }
+    if ( ! out )
+    {
+      DBG << "Can't write refresh history " << _file << endl;	// e.g. non-root
+      filesystem::unlink( tmp );
+      return;
+    }
+  }
+  if ( filesystem::rename( tmp, _file ) != 0 )
+  {
+    DBG << "Can't write refresh history " << _file << endl;
+    filesystem::unlink( tmp );
+    return;
+  }
+  _dirty = false;
+}
@@ -0,0 +1,82 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_REFRESHSCHEDULE_H_INCLUDED
+#define ZYPPER_REFRESHSCHEDULE_H_INCLUDED
+
+#include <map>
+#include <string>
+
+#include <zypp/Date.h>
+#include <zypp/Pathname.h>
+#include <zypp/RepoInfo.h>
+
+class Zypper;
+
+///////////////////////////////////////////////////////////////////
+/// \class RefreshSchedule
+/// \brief Decide when autorefresh should check a repo for new metadata.
+///
+/// Remembers for each repo when its metadata were checked and changed, and
+/// the expiration date suggested by the metadata. An autorefresh check is
+/// skipped while the metadata are not expired or if, judging by the
+/// observed changes, the repo most probably did not change since the last
+/// check. The check interval is at least libzypp's \c repo.refresh.delay
+/// and at most a week. Update repos are always checked (subject to the
+/// usual delay only).
+///
+/// Explicit \c zypper \c refresh always checks, but its outcome is
+/// recorded, too.
+///
+/// Enabled via zypper.conf(main/adaptiveRefresh). The history is stored in
+/// zypper's cache directory.
+///////////////////////////////////////////////////////////////////
+class RefreshSchedule
+{
+public:
+  /** What we know about a repo. */
+  struct Entry
+  {
+    zypp::Date firstCheck;
+    zypp::Date lastCheck;
+    zypp::Date lastChange;
+    unsigned   checks = 0;
+    unsigned   changes = 0;
+    zypp::Date expires;	///< suggested expiration of the metadata (0 if none)
+  };
+
+public:
+  /** The schedule of \a zypper_r (loaded on first use). */
+  static RefreshSchedule & instance( Zypper & zypper_r );
+
+  /** Whether zypper.conf enables the schedule. */
+  static bool enabled( Zypper & zypper_r );
+
+  /** Whether autorefresh should check \a repo_r now. */
+  bool due( const zypp::RepoInfo & repo_r, zypp::Date now_r = zypp::Date::now() ) const;
+
+  /** The minimum time between two checks of \a repo_r (in seconds). */
+  zypp::Date::Duration interval( const zypp::RepoInfo & repo_r ) const;
+
+  /** Remember the metadata of \a repo_r were checked (and whether they \a changed_r). */
+  void checked( const zypp::RepoInfo & repo_r, bool changed_r, zypp::Date now_r = zypp::Date::now() );
+
+  /** Remember the expiration date suggested by the metadata of \a repo_r. */
+  void expires( const zypp::RepoInfo & repo_r, zypp::Date expires_r );
+
+  /** Write the history if it changed (not while running without the zypp lock). */
+  void save();
+
+private:
+  explicit RefreshSchedule( zypp::Pathname file_r );
+
+  zypp::Pathname _file;
+  std::map<std::string,Entry> _entries;	///< by repo alias
+  bool _dirty = false;
+};
+
+#endif // ZYPPER_REFRESHSCHEDULE_H_INCLUDED
@@ -0,0 +1,113 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <zypp/base/Easy.h>
+#include <zypp/base/Logger.h>
+#include <zypp/Pathname.h>
+
+#include "repos.h"	// safe_lexical_cast
+#include "RepoIndex.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  enum : unsigned { LooseAuth = 1, LooseQuery = 2, ViewCount = 4 };
+
+  inline unsigned viewIndex( bool looseQuery_r, bool looseAuth_r )
+  { return ( looseAuth_r ? LooseAuth : 0 ) | ( looseQuery_r ? LooseQuery : 0 ); }
+
+  /** The string \a url_r is compared by in view \a view_r. */
+  std::string urlKey( Url url_r, unsigned view_r )
+  {
+    // first strip any trailing slash from the path in URLs before comparing
+    // (bnc #585082); we expect that the repo urls are directories.
+    url_r.setPathName( Pathname(url_r.getPathName()).asString() );
+    if ( ! view_r )
+      return url_r.asCompleteString();	// plain Url::operator==
+
+    url::ViewOption urlview = url::ViewOption::DEFAULTS + url::ViewOption::WITH_PASSWORD;
+    if ( view_r & LooseAuth )
+      urlview = urlview - url::ViewOptions::WITH_PASSWORD - url::ViewOptions::WITH_USERNAME;
+    if ( view_r & LooseQuery )
+      urlview = urlview - url::ViewOptions::WITH_QUERY_STR;
+    return url_r.asString( urlview );
+  }
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+RepoIndex::RepoIndex( const RepoManager & manager_r )
+: _repos( manager_r.repoBegin(), manager_r.repoEnd() )
+, _urls( ViewCount )
+, _urlsBuilt( ViewCount, false )
+{
+  _alias.reserve( _repos.size() );
+  _name.reserve( _repos.size() );
+  for ( size_t pos = 0; pos < _repos.size(); ++pos )
+  {
+    _alias.emplace( _repos[pos].alias(), pos );	// emplace keeps the first one
+    _name.emplace( _repos[pos].name(), pos );
+  }
+  DBG << "Indexed " << _repos.size() << " repos" << endl;
+}
+
+const RepoInfo * RepoIndex::find( const std::string & str_r ) const
+{
+  size_t pos = _repos.size();
+  auto lookup = [&str_r,&pos]( const Index & index_r ) {
+    auto it = index_r.find( str_r );
+    if ( it != index_r.end() && it->second < pos )
+      pos = it->second;
+  };
+  lookup( _alias );
+  lookup( _name );
+
+  unsigned number = 0;
+  safe_lexical_cast( str_r, number );
+  if ( number && number - 1 < pos )	// repo numbers start with 1
+    pos = number - 1;
+
+  return pos < _repos.size() ? &_repos[pos] : nullptr;
+}
+
+const RepoInfo * RepoIndex::findUrl( const Url & url_r, bool looseQuery_r, bool looseAuth_r ) const
+{
+  unsigned view = viewIndex( looseQuery_r, looseAuth_r );
+  try
+  {
+    const Index & index { urlIndex( view ) };
+    auto it = index.find( urlKey( url_r, view ) );
+    if ( it != index.end() )
+      return &_repos[it->second];
+  }
+  catch ( const url::UrlException & ) {}
+  return nullptr;
+}
+
+const RepoIndex::Index & RepoIndex::urlIndex( unsigned view_r ) const
+{
+  Index & index { _urls[view_r] };
+  if ( ! _urlsBuilt[view_r] )
+  {
+    for ( size_t pos = 0; pos < _repos.size(); ++pos )
+    {
+      for_( urlit, _repos[pos].baseUrlsBegin(), _repos[pos].baseUrlsEnd() )
+      {
+        try
+        {
+          index.emplace( urlKey( *urlit, view_r ), pos );
+        }
+        catch ( const url::UrlException & ) {}
+      }
+    }
+    _urlsBuilt[view_r] = true;
+    DBG << "Indexed " << index.size() << " repo URLs for view " << view_r << endl;
+  }
+  return index;
+}
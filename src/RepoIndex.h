@@ -0,0 +1,65 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_REPOINDEX_H_INCLUDED
+#define ZYPPER_REPOINDEX_H_INCLUDED
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <zypp/RepoInfo.h>
+#include <zypp/RepoManager.h>
+#include <zypp/Url.h>
+
+///////////////////////////////////////////////////////////////////
+/// \class RepoIndex
+/// \brief Hash index of the repos known to a \ref zypp::RepoManager.
+///
+/// Looks up repos by alias, number, name or base URL the way
+/// \ref match_repo does, but without scanning all repos and parsing
+/// their URLs for each argument. The URL keys for a combination of
+/// loose-auth/loose-query are computed on first use.
+///
+/// The index is a snapshot. \ref Zypper::repoIndex rebuilds it if the
+/// number of repos changed; after modifying a repo call
+/// \ref Zypper::invalidateRepoIndex.
+///
+/// If several repos match, the one with the lowest number wins.
+///////////////////////////////////////////////////////////////////
+class RepoIndex
+{
+public:
+  /** Index the repos known to \a manager_r. */
+  explicit RepoIndex( const zypp::RepoManager & manager_r );
+
+  /** Number of indexed repos. */
+  size_t size() const
+  { return _repos.size(); }
+
+  /** The repo matching \a str_r by alias, number or name (or \c nullptr). */
+  const zypp::RepoInfo * find( const std::string & str_r ) const;
+
+  /** The repo having a base URL matching \a url_r (or \c nullptr).
+   * Trailing slashes in the URLs path are ignored (bnc #585082).
+   */
+  const zypp::RepoInfo * findUrl( const zypp::Url & url_r, bool looseQuery_r = false, bool looseAuth_r = false ) const;
+
+private:
+  typedef std::unordered_map<std::string,size_t> Index;	///< key -> position in _repos
+
+  /** The URL key index for a loose-auth/loose-query combination. */
+  const Index & urlIndex( unsigned view_r ) const;
+
+  std::vector<zypp::RepoInfo> _repos;	///< in repo number order
+  Index _alias;
+  Index _name;
+  mutable std::vector<Index> _urls;	///< per view, built on demand
+  mutable std::vector<bool> _urlsBuilt;
+};
+
+#endif // ZYPPER_REPOINDEX_H_INCLUDED
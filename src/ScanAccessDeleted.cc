@@ -0,0 +1,353 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <dirent.h>
+#include <pwd.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/base/Exception.h>
+#include <zypp/sat/LookupAttr.h>
+#include <zypp/Package.h>
+
+#include "main.h"
+#include "utils/Parallel.h"
+#include "ScanAccessDeleted.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  /** Elapsed time since \a start_r in ms. */
+  inline long msSince( const Clock::time_point & start_r )
+  { return std::chrono::duration_cast<std::chrono::milliseconds>( Clock::now() - start_r ).count(); }
+
+  /** Deleted files we are not interested in (devices, shared memory, ...). */
+  inline bool ignoreFile( const std::string & file_r )
+  {
+    return( file_r.empty() || file_r[0] != '/'
+            || str::hasPrefix( file_r, "/dev/" )
+            || str::hasPrefix( file_r, "/proc/" )
+            || str::hasPrefix( file_r, "/memfd:" )
+            || str::hasPrefix( file_r, "/SYSV" ) );
+  }
+
+  /** Strip a trailing " (deleted)" from \a file_r. Return false if there is none. */
+  inline bool stripDeleted( std::string & file_r )
+  {
+    static const std::string tag { " (deleted)" };
+    if ( ! str::hasSuffix( file_r, tag ) )
+      return false;
+    file_r.erase( file_r.size() - tag.size() );
+    return true;
+  }
+
+  /** The pathname field of a /proc/<pid>/maps line (may contain blanks). */
+  inline std::string mapsPathname( const std::string & line_r )
+  {
+    // address perms offset dev inode pathname
+    const char * p = line_r.c_str();
+    for ( unsigned field = 0; field < 5; ++field )
+    {
+      while ( *p && *p != ' ' ) ++p;
+      while ( *p == ' ' ) ++p;
+    }
+    return p;
+  }
+
+  /** Resolve the directory part of package file names, caching the result.
+   * The kernel reports mapped files with all symlinks resolved (\c /usr/lib64/libc.so.6),
+   * while a package may own them below a symlinked directory (\c /lib64/libc.so.6 on
+   * usrmerge systems).
+   */
+  struct CanonicalPath
+  {
+    /** The canonical path of \a file_r or an empty string if its directory does not resolve. */
+    std::string operator()( const std::string & file_r )
+    {
+      std::string::size_type pos = file_r.rfind( '/' );
+      if ( pos == std::string::npos )
+        return std::string();
+      const std::string & dir { file_r.substr( 0, pos ) };
+
+      auto it = _cache.find( dir );
+      if ( it == _cache.end() )
+      {
+        char * resolved = ::realpath( dir.empty() ? "/" : dir.c_str(), nullptr );
+        it = _cache.emplace( dir, resolved ? resolved : "" ).first;
+        ::free( resolved );
+      }
+      if ( it->second.empty() )
+        return std::string();
+      return ( it->second == "/" ? "" : it->second ) + file_r.substr( pos );
+    }
+  private:
+    std::unordered_map<std::string,std::string> _cache;
+  };
+
+  /** Numeric subdirectories of /proc. */
+  std::vector<std::string> listPids()
+  {
+    std::vector<std::string> ret;
+    DIR * dir = ::opendir( "/proc" );
+    if ( ! dir )
+      ZYPP_THROW( Exception( ( str::Format(_("Can't read %1%")) % "/proc" ).str() ) );
+
+    while ( struct dirent * entry = ::readdir( dir ) )
+    {
+      const char * name = entry->d_name;
+      if ( *name >= '1' && *name <= '9' && name[strspn( name, "0123456789" )] == '\0' )
+        ret.push_back( name );
+    }
+    ::closedir( dir );
+    return ret;
+  }
+
+  /** Value of \a key_r ("PPid:") in /proc/<pid>/status (first field only). */
+  std::string statusValue( const std::string & status_r, const std::string & key_r )
+  {
+    std::string::size_type pos = status_r.find( "\n" + key_r );
+    if ( pos == std::string::npos )
+      return std::string();
+    pos += key_r.size() + 1;
+    pos = status_r.find_first_not_of( " \t", pos );
+    std::string::size_type end = status_r.find_first_of( " \t\n", pos );
+    return status_r.substr( pos, end == std::string::npos ? std::string::npos : end - pos );
+  }
+
+  inline std::string readFile( const std::string & file_r )
+  {
+    std::ifstream in( file_r );
+    return std::string( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+  }
+
+  /** The cgroup path from /proc/<pid>/cgroup, preferring the unified hierarchy.
+   * \code
+   *   0::/system.slice/sshd.service
+   *   1:name=systemd:/system.slice/sshd.service
+   * \endcode
+   */
+  std::string readCgroup( const std::string & file_r )
+  {
+    std::string ret;
+    std::ifstream in( file_r );
+    for ( std::string line; std::getline( in, line ); )
+    {
+      if ( str::hasPrefix( line, "0::" ) )
+        return line.substr( 3 );
+      std::string::size_type pos = line.find( ":name=systemd:" );
+      if ( pos != std::string::npos )
+        ret = line.substr( pos + 14 );
+    }
+    return ret;
+  }
+
+  /** Split a cgroup path into its components. */
+  inline std::vector<std::string> cgroupComponents( const std::string & cgroup_r )
+  {
+    std::vector<std::string> ret;
+    str::split( cgroup_r, std::back_inserter(ret), "/" );
+    return ret;
+  }
+
+  inline bool isUnitName( const std::string & name_r )
+  { return str::hasSuffix( name_r, ".service" ) || str::hasSuffix( name_r, ".scope" ); }
+
+  /** Fill \a proc_r if process \a pid_r accesses deleted files matching \a filter_r. */
+  bool scanProcess( const std::string & pid_r, const ScanAccessDeleted::FileFilter & filter_r, ScanAccessDeleted::ProcInfo & proc_r )
+  {
+    const std::string procdir { "/proc/" + pid_r };
+    std::set<std::string> files;
+
+    auto remember = [&]( std::string file_r ) {
+      if ( ! stripDeleted( file_r ) || ignoreFile( file_r ) )
+        return;
+      if ( ! filter_r.empty() && ! filter_r.count( file_r ) )
+        return;
+      files.insert( std::move(file_r) );
+    };
+
+    {
+      char buf[PATH_MAX+1];
+      ssize_t len = ::readlink( (procdir + "/exe").c_str(), buf, PATH_MAX );
+      if ( len > 0 )
+        remember( std::string( buf, len ) );
+    }
+    {
+      std::ifstream maps( procdir + "/maps" );
+      for ( std::string line; std::getline( maps, line ); )
+      {
+        if ( str::hasSuffix( line, " (deleted)" ) )	// quick pre-check
+          remember( mapsPathname( line ) );
+      }
+    }
+
+    if ( files.empty() )
+      return false;
+
+    const std::string & status { readFile( procdir + "/status" ) };
+    proc_r.pid = pid_r;
+    proc_r.ppid = statusValue( status, "PPid:" );
+    proc_r.puid = statusValue( status, "Uid:" );
+    proc_r.command = str::rtrim( readFile( procdir + "/comm" ) );
+    proc_r.cgroup = readCgroup( procdir + "/cgroup" );
+    proc_r.files.assign( files.begin(), files.end() );
+    return true;
+  }
+
+  /** Resolve uid to login name, caching the result. */
+  struct LoginCache
+  {
+    const std::string & operator()( const std::string & uid_r )
+    {
+      auto it = _cache.find( uid_r );
+      if ( it == _cache.end() )
+      {
+        struct passwd * pw = ::getpwuid( str::strtonum<uid_t>( uid_r ) );
+        it = _cache.emplace( uid_r, pw ? pw->pw_name : uid_r ).first;
+      }
+      return it->second;
+    }
+  private:
+    std::map<std::string,std::string> _cache;
+  };
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+std::string ScanAccessDeleted::ProcInfo::service() const
+{
+  // Like CheckAccessDeleted::findService: system services only
+  if ( ! str::hasPrefix( cgroup, "/system.slice/" ) )
+    return std::string();
+  std::string ret { unit() };
+  return str::hasSuffix( ret, ".service" ) ? str::stripSuffix( ret, ".service" ) : std::string();
+}
+
+std::string ScanAccessDeleted::ProcInfo::unit() const
+{
+  const std::vector<std::string> & components { cgroupComponents( cgroup ) };
+  for ( auto it = components.rbegin(); it != components.rend(); ++it )
+  {
+    if ( isUnitName( *it ) )
+      return *it;
+  }
+  return std::string();
+}
+
+std::string ScanAccessDeleted::ProcInfo::slice() const
+{
+  const std::vector<std::string> & components { cgroupComponents( cgroup ) };
+  auto it = components.rbegin();
+  while ( it != components.rend() && ! isUnitName( *it ) )
+    ++it;
+  for ( ; it != components.rend(); ++it )
+  {
+    if ( str::hasSuffix( *it, ".slice" ) )
+      return *it;
+  }
+  return std::string();
+}
+
+ScanAccessDeleted & ScanAccessDeleted::check()
+{
+  _data.clear();
+  std::vector<std::pair<std::string,long>> timing;
+
+  Clock::time_point start { Clock::now() };
+  const std::vector<std::string> & pids { listPids() };
+  timing.push_back( { "enumerate", msSince( start ) } );
+
+  start = Clock::now();
+  std::vector<ProcInfo> found( pids.size() );
+  std::vector<char> hit( pids.size(), 0 );
+  parallel::forEach( pids.size(), [&]( size_t idx ) {
+    hit[idx] = scanProcess( pids[idx], _filter, found[idx] );
+  } );
+  timing.push_back( { "scan", msSince( start ) } );
+
+  start = Clock::now();
+  LoginCache login;
+  for ( size_t idx = 0; idx < pids.size(); ++idx )
+  {
+    if ( ! hit[idx] )
+      continue;
+    found[idx].login = login( found[idx].puid );
+    _data.push_back( std::move(found[idx]) );
+  }
+  timing.push_back( { "collect", msSince( start ) } );
+
+  MIL << "Scanned " << pids.size() << " processes (" << parallel::workers( pids.size() ) << " threads"
+      << ( _filter.empty() ? std::string() : ", " + str::numstring( _filter.size() ) + " files" ) << "): "
+      << _data.size() << " access deleted files" << endl;
+
+  if ( ! _debugFile.empty() )
+  {
+    std::ofstream debug( _debugFile.c_str() );
+    debug << "# processes: " << pids.size() << endl;
+    debug << "# filter:    " << ( _filter.empty() ? std::string("none") : str::numstring( _filter.size() ) + " files" ) << endl;
+    for ( const auto & phase : timing )
+      debug << "# phase " << phase.first << ": " << phase.second << " ms" << endl;
+    for ( const ProcInfo & proc : _data )
+      debug << proc << endl;
+  }
+  else
+  {
+    for ( const auto & phase : timing )
+      DBG << "phase " << phase.first << ": " << phase.second << " ms" << endl;
+  }
+  return *this;
+}
+
+ScanAccessDeleted::FileFilter ScanAccessDeleted::filesTouchedBy( const sat::Transaction & trans_r )
+{
+  FileFilter ret;
+  CanonicalPath canonical;
+  unsigned unresolved = 0;
+  for ( const sat::Transaction::Step & step : trans_r )
+  {
+    sat::Solvable slv { step.satSolvable() };
+    if ( ! slv || ! slv.isKind<Package>() )
+      continue;
+    sat::LookupAttr q( sat::SolvAttr::filelist, slv );
+    for ( sat::LookupAttr::iterator it = q.begin(); it != q.end(); ++it )
+    {
+      std::string file { it.asString() };
+      std::string path { canonical( file ) };
+      if ( path.empty() )
+        ++unresolved;	// directory not yet on disk, so no running process maps the file
+      else if ( path != file )
+        ret.insert( std::move(path) );
+      ret.insert( std::move(file) );
+    }
+  }
+  MIL << "Transaction touches " << ret.size() << " files (" << unresolved << " not yet on disk)" << endl;
+  return ret;
+}
+
+std::ostream & operator<<( std::ostream & str, const ScanAccessDeleted::ProcInfo & obj )
+{
+  str << "<" << obj.pid << "|" << obj.ppid << "|" << obj.puid << "|" << obj.login << "|" << obj.command << "|" << obj.cgroup << ">";
+  for ( const std::string & file : obj.files )
+    str << endl << "    " << file;
+  return str;
+}
@@ -0,0 +1,109 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_SCANACCESSDELETED_H_INCLUDED
+#define ZYPPER_SCANACCESSDELETED_H_INCLUDED
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <unordered_set>
+
+#include <zypp/Pathname.h>
+#include <zypp/sat/Transaction.h>
+
+///////////////////////////////////////////////////////////////////
+/// \class ScanAccessDeleted
+/// \brief Check for running processes which access deleted executables or libraries.
+///
+/// A replacement for libzypp's \ref zypp::CheckAccessDeleted which does not
+/// call \c lsof but reads \c /proc/<pid>/maps and \c /proc/<pid>/exe directly.
+/// The processes are scanned in parallel.
+///
+/// The processes cgroup is read during the scan, so \ref ProcInfo::service
+/// and \ref ProcInfo::unit do not need to access /proc again.
+///
+/// After a commit the check can be restricted to the files touched by the
+/// transaction (\ref setFileFilter, \ref filesTouchedBy), which is much
+/// cheaper than looking at every deleted file a process maps.
+///
+/// \code
+///   ScanAccessDeleted checker;
+///   checker.check();
+///   for ( const auto & procInfo : checker )
+///     ...
+/// \endcode
+///////////////////////////////////////////////////////////////////
+class ScanAccessDeleted
+{
+public:
+  /** Data about one running process accessing deleted files. */
+  struct ProcInfo
+  {
+    std::string pid;			///< process ID
+    std::string ppid;			///< parent process ID
+    std::string puid;			///< process user ID
+    std::string login;			///< process login name
+    std::string command;		///< process command name
+    std::vector<std::string> files;	///< list of deleted executables or libraries accessed
+    std::string cgroup;			///< cgroup path in the unified (or v1 name=systemd) hierarchy
+
+    /** Guess the systemd service name (empty if none). */
+    std::string service() const;
+
+    /** The systemd unit (service or scope) the process belongs to (empty if none). */
+    std::string unit() const;
+
+    /** The systemd slice containing \ref unit (empty if none). */
+    std::string slice() const;
+  };
+
+  typedef std::vector<ProcInfo>::const_iterator const_iterator;
+  typedef std::unordered_set<std::string> FileFilter;
+
+public:
+  /** Default ctor (no filter, call \ref check explicitly). */
+  ScanAccessDeleted()
+  {}
+
+  /** Only report processes accessing one of \a files_r (an empty filter matches all deleted files). */
+  void setFileFilter( FileFilter files_r )
+  { _filter = std::move(files_r); }
+
+  /** Write the per phase timing and the collected data to \a debugFile_r. */
+  void setDebugOutputFile( zypp::Pathname debugFile_r )
+  { _debugFile = std::move(debugFile_r); }
+
+  /** Scan /proc for processes accessing deleted files.
+   * \throws zypp::Exception if /proc is not readable.
+   */
+  ScanAccessDeleted & check();
+
+  /** The files owned by the solvables of all steps in \a trans_r.
+   * Files below a symlinked directory are included with the symlinks
+   * resolved as well, as the kernel reports them.
+   * \note Call this before committing the transaction; after the commit
+   * the erased solvables are no longer available in the pool.
+   */
+  static FileFilter filesTouchedBy( const zypp::sat::Transaction & trans_r );
+
+public:
+  bool empty() const			{ return _data.empty(); }
+  size_t size() const			{ return _data.size(); }
+  const_iterator begin() const		{ return _data.begin(); }
+  const_iterator end() const		{ return _data.end(); }
+
+private:
+  FileFilter _filter;
+  zypp::Pathname _debugFile;
+  std::vector<ProcInfo> _data;
+};
+
+/** \relates ScanAccessDeleted::ProcInfo Stream output */
+std::ostream & operator<<( std::ostream & str, const ScanAccessDeleted::ProcInfo & obj );
+
+#endif // ZYPPER_SCANACCESSDELETED_H_INCLUDED
@@ -0,0 +1,150 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/CheckSum.h>
+#include <zypp/PathInfo.h>
+#include <zypp/RepoStatus.h>
+#include <zypp/parser/yum/RepomdFileReader.h>
+
+#include "main.h"
+#include "Zypper.h"
+#include "SolvFingerprint.h"
+#include "utils/misc.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  /** The \c <tags> section of \a repomd_r (keywords and distro tags end up in the solv file). */
+  std::string repomdTags( const Pathname & repomd_r )
+  {
+    std::ifstream in( repomd_r.c_str() );
+    std::ostringstream content;
+    content << in.rdbuf();
+    const std::string & str { content.str() };
+
+    std::string::size_type begin = str.find( "<tags>" );
+    std::string::size_type end = str.find( "</tags>" );
+    if ( begin == std::string::npos || end == std::string::npos || end < begin )
+      return std::string();
+    return str.substr( begin, end - begin );
+  }
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+SolvFingerprint::SolvFingerprint( Zypper & zypper_r, const RepoInfo & repo_r )
+: _zypper( zypper_r )
+, _repo( repo_r )
+, _solvDir( Pathname::assertprefix( zypper_r.config().root_dir, zypper_r.config().rm_options.repoSolvCachePath ) / repo_r.escaped_alias() )
+{}
+
+bool SolvFingerprint::enabled( Zypper & zypper_r )
+{ return zypper_r.config().keepUnchangedSolv; }
+
+std::string SolvFingerprint::compute() const
+{
+  const Pathname & repomd { _repo.metadataPath() / "repodata/repomd.xml" };
+  if ( _repo.type() != repo::RepoType::RPMMD || ! PathInfo( repomd ).isFile() )
+    return std::string();
+
+  std::set<std::string> parts;	// sorted, so the order in repomd.xml does not matter
+  try
+  {
+    parser::yum::RepomdFileReader( repomd, [&parts]( auto && loc_r, auto && type_r ) -> bool {
+      const std::string & type { str::asString( type_r ) };
+      if ( isDownloadedRepomdType( type ) )	// parsed into the solv file
+        parts.insert( type + " " + loc_r.checksum().type() + ":" + loc_r.checksum().checksum() );
+      return true;
+    } );
+  }
+  catch ( const Exception & e )
+  {
+    ZYPP_CAUGHT( e );
+    return std::string();	// let libzypp handle (and report) it
+  }
+  if ( parts.empty() )
+    return std::string();
+
+  std::ostringstream key;
+  for ( const std::string & part : parts )
+    key << part << endl;
+  key << repomdTags( repomd ) << endl;
+  std::istringstream keystr( key.str() );
+  return CheckSum::sha256( keystr ).checksum();
+}
+
+SolvFingerprint::Stored SolvFingerprint::stored() const
+{
+  Stored ret;
+  std::ifstream in( ( _solvDir / "zypper-fingerprint" ).c_str() );
+  std::getline( in, ret.fingerprint );
+  std::getline( in, ret.cookie );
+  return ret;
+}
+
+void SolvFingerprint::store( const Stored & stored_r ) const
+{
+  const Pathname & file { _solvDir / "zypper-fingerprint" };
+  std::ofstream out( file.c_str() );
+  out << stored_r.fingerprint << endl << stored_r.cookie << endl;
+  if ( ! out )
+  {
+    DBG << "Can't write solv fingerprint " << file << endl;	// e.g. non-root
+    filesystem::unlink( file );
+  }
+}
+
+bool SolvFingerprint::keepUnchanged()
+{
+  const Pathname & cookie { _solvDir / "cookie" };
+  if ( ! PathInfo( _solvDir / "solv" ).isFile() )
+    return false;
+
+  const RepoStatus & rawStatus { _zypper.repoManager().metadataStatus( _repo ) };
+  const std::string & solvStatus { RepoStatus::fromCookieFile( cookie ).checksum() };
+  if ( rawStatus.empty() || solvStatus == rawStatus.checksum() )
+    return false;	// nothing to build or up to date anyway
+
+  // The fingerprint describes the solv file only if nobody rebuilt it since.
+  Stored fp { stored() };
+  if ( fp.fingerprint.empty() || fp.cookie != solvStatus )
+    return false;
+
+  const std::string & fingerprint { compute() };
+  if ( fingerprint.empty() || fingerprint != fp.fingerprint )
+    return false;
+
+  rawStatus.saveToCookieFile( cookie );
+  fp.cookie = rawStatus.checksum();
+  store( fp );
+  MIL << "Keeping the solv file of " << _repo.alias() << ", fingerprint " << fingerprint << " unchanged" << endl;
+  _zypper.out().info( str::Format(_("The data in the cache of '%s' did not change, keeping it.")) % _repo.asUserString(), Out::HIGH );
+  return true;
+}
+
+void SolvFingerprint::save()
+{
+  Stored fp { compute(), RepoStatus::fromCookieFile( _solvDir / "cookie" ).checksum() };
+  // the solv file must be built from the current raw metadata
+  if ( fp.fingerprint.empty() || fp.cookie.empty() || fp.cookie != _zypper.repoManager().metadataStatus( _repo ).checksum() )
+  {
+    filesystem::unlink( _solvDir / "zypper-fingerprint" );
+    return;
+  }
+  const Stored & old { stored() };
+  if ( fp.fingerprint == old.fingerprint && fp.cookie == old.cookie )
+    return;
+  store( fp );
+}
@@ -0,0 +1,80 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_SOLVFINGERPRINT_H_INCLUDED
+#define ZYPPER_SOLVFINGERPRINT_H_INCLUDED
+
+#include <string>
+
+#include <zypp/Pathname.h>
+#include <zypp/RepoInfo.h>
+
+class Zypper;
+
+///////////////////////////////////////////////////////////////////
+/// \class SolvFingerprint
+/// \brief Keep a repos solv file if the metadata it is built from did not change.
+///
+/// libzypp rebuilds the solv file whenever the raw metadata status (the
+/// checksum of repomd.xml) changed. But a new repomd.xml does not necessarily
+/// come with new data: a republished repo gets a new revision, and files not
+/// parsed into the solv file (\c other, sqlite or zchunk variants) may change
+/// on their own.
+///
+/// The fingerprint of a rpm-md repo covers the type and checksum of each
+/// metadata file libzypp downloads and parses into the solv file (see
+/// \ref isDownloadedRepomdType) and the repos tags. It is stored next
+/// to the solv file whenever the solv file is built, together with the
+/// checksum in the solv cookie. The fingerprint is trusted only as long as
+/// the cookie is unchanged, i.e. the solv file was not rebuilt by another
+/// libzypp client since. If the raw metadata changed but the fingerprint
+/// did not, \ref keepUnchanged marks the solv file as up to date, so libzypp
+/// won't rebuild it.
+///
+/// \note The repo revision stored in the kept solv file is not updated.
+///
+/// Enabled via zypper.conf(main/keepUnchangedSolv).
+///////////////////////////////////////////////////////////////////
+class SolvFingerprint
+{
+public:
+  SolvFingerprint( Zypper & zypper_r, const zypp::RepoInfo & repo_r );
+
+  /** Whether zypper.conf enables fingerprints. */
+  static bool enabled( Zypper & zypper_r );
+
+  /** Mark an outdated solv file as up to date if its fingerprint did not change.
+   * \return Whether the solv file was kept.
+   */
+  bool keepUnchanged();
+
+  /** Remember the fingerprint of the raw metadata the solv file was built from. */
+  void save();
+
+private:
+  /** Fingerprint of the current raw metadata (empty if not rpm-md). */
+  std::string compute() const;
+
+  /** A stored fingerprint and the solv cookie checksum it belongs to. */
+  struct Stored
+  {
+    std::string fingerprint;
+    std::string cookie;
+  };
+
+  /** The stored fingerprint. */
+  Stored stored() const;
+
+  /** Store \a stored_r. */
+  void store( const Stored & stored_r ) const;
+
+  Zypper & _zypper;
+  zypp::RepoInfo _repo;
+  zypp::Pathname _solvDir;
+};
+
+#endif // ZYPPER_SOLVFINGERPRINT_H_INCLUDED
@@ -9,6 +9,8 @@
 /** \file SolverRequester.cc
  *
  */
+#include <algorithm>
+
 #include <zypp/ZYppFactory.h>
 #include <zypp/base/LogTools.h>
 
@@ -85,6 +87,51 @@ namespace
     return pkg_spec_to_poolquery( cap, repos );
   }
 
+  inline bool hasGlobChars( const std::string & name_r )
+  { return name_r.find_first_of( "*?[" ) != std::string::npos; }
+
+  /** The items matching the name of \a cap (same as \ref pkg_spec_to_poolquery).
+   * Names without glob characters are looked up in the pools ident index, so
+   * long lists of package names don't scan the whole pool once per name.
+   */
+  std::vector<PoolItem> pkg_spec_matches( const Capability & cap, const std::list<std::string> & repos )
+  {
+    std::vector<PoolItem> ret;
+    sat::Solvable::SplitIdent splid( cap.detail().name() );
+    if ( hasGlobChars( splid.name().asString() ) )
+    {
+      PoolQuery q { pkg_spec_to_poolquery( cap, repos ) };
+      ret.assign( q.poolItemBegin(), q.poolItemEnd() );
+      return ret;
+    }
+
+    Edition::MatchRange range( cap.detail().op(), cap.detail().ed() );
+    Arch arch( cap.detail().arch() );
+    const ResPool & pool( ResPool::instance() );
+    for_( it, pool.byIdentBegin( splid.ident() ), pool.byIdentEnd( splid.ident() ) )
+    {
+      const PoolItem & pi( *it );
+      if ( !repos.empty() && std::find( repos.begin(), repos.end(), pi.repoInfo().alias() ) == repos.end() )
+        continue;
+      if ( cap.detail().isVersioned() && ! overlaps( Edition::MatchRange( Rel::EQ, pi.edition() ), range ) )
+        continue;
+      if ( arch != Arch_empty && pi.arch() != arch )
+        continue;
+      ret.push_back( pi );
+    }
+    DBG << "ident " << splid.ident() << " " << cap.detail().op() << " " << cap.detail().ed() << " " << arch
+        << ": " << ret.size() << " matches" << endl;
+    return ret;
+  }
+
+  std::vector<PoolItem> pkg_spec_matches( const Capability & cap, const std::string & repo )
+  {
+    std::list<std::string> repos;
+    if ( !repo.empty() )
+      repos.push_back( repo );
+    return pkg_spec_matches( cap, repos );
+  }
+
   std::set<PoolItem> get_installed_providers( const Capability & cap )
   {
     std::set<PoolItem> providers;
@@ -222,16 +269,13 @@ void SolverRequester::install( const PackageSpec & pkg )
   // first try by name
   if ( !_opts.force_by_cap )
   {
-    PoolQuery q;
-    if ( !pkg.repo_alias.empty() )
-      q = pkg_spec_to_poolquery( pkg.parsed_cap, pkg.repo_alias );
-    else
-      q = pkg_spec_to_poolquery( pkg.parsed_cap, _opts.from_repos );
+    const std::vector<PoolItem> & matches { !pkg.repo_alias.empty() ? pkg_spec_matches( pkg.parsed_cap, pkg.repo_alias )
+                                                                    : pkg_spec_matches( pkg.parsed_cap, _opts.from_repos ) };
 
     // get the best matching items and tag them for installation.
     // FIXME this ignores vendor lock - we need some way to do --from which
     // would respect vendor lock: e.g. a new Selectable::updateCandidateObj(Options&)
-    PoolItemBest bestMatches( q.begin(), q.end(), PoolItemBest::preferNotLocked );
+    PoolItemBest bestMatches( matches.begin(), matches.end(), PoolItemBest::preferNotLocked );
 
     if ( !bestMatches.empty() )
     {
@@ -313,6 +357,8 @@ void SolverRequester::install( const PackageSpec & pkg )
 
     addFeedback( Feedback::NOT_FOUND_NAME_TRYING_CAPS, pkg );
     // Quick check whether there would have been matches with different case..
+    PoolQuery q { !pkg.repo_alias.empty() ? pkg_spec_to_poolquery( pkg.parsed_cap, pkg.repo_alias )
+                                          : pkg_spec_to_poolquery( pkg.parsed_cap, _opts.from_repos ) };
     getCiMatchHint( q, ciMatchHint );
   }
 
@@ -355,12 +401,12 @@ void SolverRequester::remove( const PackageSpec & pkg )
   // first try by name
   if ( !_opts.force_by_cap )
   {
-    PoolQuery q = pkg_spec_to_poolquery( pkg.parsed_cap, "" );
+    const std::vector<PoolItem> & matches { pkg_spec_matches( pkg.parsed_cap, "" ) };
 
-    if ( !q.empty() )
+    if ( !matches.empty() )
     {
       bool got_installed = false;
-      for_( it, q.poolItemBegin(), q.poolItemEnd() )
+      for_( it, matches.begin(), matches.end() )
       {
         if ( it->status().isInstalled() )
         {
@@ -389,6 +435,7 @@ void SolverRequester::remove( const PackageSpec & pkg )
 
     addFeedback( Feedback::NOT_FOUND_NAME_TRYING_CAPS, pkg );
     // Quick check whether there would have been matches with different case..
+    PoolQuery q { pkg_spec_to_poolquery( pkg.parsed_cap, "" ) };
     getCiMatchHint( q, ciMatchHint );
   }
 
@@ -22,6 +22,7 @@
 
 #include "Zypper.h"
 #include "PackageArgs.h"
+#include "PatchTable.h"
 #include "utils/misc.h" // for ResKindSet; might make sense to move this elsewhere
 #include "global-settings.h"
 
@@ -91,6 +92,10 @@ struct CliMatchPatch
   bool operator()( const PoolItem & pi_r ) const
   { return pi_r.isKind<Patch>() && operator()( asKind<Patch>(pi_r) ); }
 
+  /** Same as for the Patch (libzypp maps several category/severity strings to one enum, so the strings are compared). */
+  bool operator()( const PatchTable::Entry & entry_r ) const
+  { return operator()( entry_r.patch ); }
+
 private:
   friend class SolverRequester;	// SolverRequester::updatePatches uses _dateBefore
   Date _dateBefore;
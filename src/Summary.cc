@@ -6,9 +6,11 @@
 \*---------------------------------------------------------------------------*/
 
 #include <string.h>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string_view>
+#include <unordered_map>
 
 #include <zypp/ZYppFactory.h>
 #include <zypp/base/LogTools.h>
@@ -194,18 +196,13 @@ Summary::Summary( const ResPool & pool, SummaryHints summaryHints, const ViewOpt
 
 // --------------------------------------------------------------------------
 
-struct ResNameCompare
+namespace
 {
-  bool operator()( ResObject::constPtr r1, ResObject::constPtr r2 ) const
-  {
-    int ret = ::strcoll( r1->name().c_str(), r2->name().c_str() );
-    if ( ret == 0 )
-      return r1->edition() < r2->edition();
-    return ret < 0;
-  }
-};
-
-typedef std::map<Resolvable::Kind, std::set<ResObject::constPtr, ResNameCompare> > KindToResObjectSet;
+  /** Items to be installed, per kind. */
+  typedef std::map<ResKind, std::vector<ResObject::constPtr>> KindToResObjectList;
+  /** Items to be removed, per ident (kind:name); sorted by edition once indexed. */
+  typedef std::unordered_map<IdString, std::vector<ResObject::constPtr>> IdentToResObjectList;
+} // namespace
 
 // --------------------------------------------------------------------------
 
@@ -216,6 +213,7 @@ void Summary::readPool( const ResPool & pool )
   _need_reboot_nonpatch = false;
   _need_restart = false;
   _inst_pkg_total = 0;
+  _notupdated_collected = false;
 
   _todownload = ByteCount();
   _incache = ByteCount();
@@ -232,10 +230,13 @@ void Summary::readPool( const ResPool & pool )
     if ( s->installedSize() > 1 || ( s->installedSize() == 1 && s->toInstall() ) )
       _multiInstalled.insert( s->name() );
   }
-  // collect resolvables to be installed/removed
 
-  KindToResObjectSet to_be_installed;
-  KindToResObjectSet to_be_removed;
+  // Index the transaction once: the items to be installed in plain lists,
+  // the items to be removed by ident, so an install can be matched against
+  // the removals of the same name without scanning them all (upgrades of
+  // several thousand packages in a dup).
+  KindToResObjectList to_be_installed;
+  IdentToResObjectList to_be_removed;
 
   MIL << "Pool contains " << pool.size() << " items." << std::endl;
   DBG << "Install summary:" << endl;
@@ -263,7 +264,7 @@ void Summary::readPool( const ResPool & pool )
       if (it->status().isToBeInstalled())
       {
         DBG << "<install>   ";
-        to_be_installed[it->kind()].insert(it->resolvable());
+        to_be_installed[it->kind()].push_back(it->resolvable());
 
         if ( it->isKind( ResKind::package ) ) {
           Package::constPtr package = asKind<Package>( it->resolvable() );
@@ -276,12 +277,20 @@ void Summary::readPool( const ResPool & pool )
       if (it->status().isToBeUninstalled())
       {
         DBG << "<uninstall> ";
-        to_be_removed[it->kind()].insert(it->resolvable());
+        to_be_removed[it->ident()].push_back(it->resolvable());
       }
       DBG << *it << endl;
     }
   }
 
+  // multiple removals of the same ident are matched in edition order
+  for ( auto & ent : to_be_removed )
+  {
+    if ( ent.second.size() > 1 )
+      std::sort( ent.second.begin(), ent.second.end(),
+                 []( const ResObject::constPtr & lhs, const ResObject::constPtr & rhs ) { return lhs->edition() < rhs->edition(); } );
+  }
+
   if ( hasViewOption( PATCH_REBOOT_RULES ) ) {
     // bsc#1183268: Patch reboot-needed flag overrules included packages.
     // Work around the unfortunate case, where a maintenance patch's metadata
@@ -299,7 +308,7 @@ void Summary::readPool( const ResPool & pool )
   }
 
   for ( const auto & spkg : Zypper::instance().runtimeData().srcpkgs_to_install )
-  { to_be_installed[ResKind::srcpackage].insert(spkg); }
+  { to_be_installed[ResKind::srcpackage].push_back(spkg); }
 
   // total packages to download & install
   // (packages & srcpackages only - patches, patterns, and products are virtual)
@@ -340,9 +349,11 @@ void Summary::readPool( const ResPool & pool )
 
       // find in to_be_removed:
       bool upgrade_downgrade = false;
-      for_( rmit, to_be_removed[res->kind()].begin(), to_be_removed[res->kind()].end() )
+      IdentToResObjectList::iterator removed = to_be_removed.find( res->ident() );
+      if ( removed != to_be_removed.end() )
       {
-        if ( res->name() == (*rmit)->name() )
+        std::vector<ResObject::constPtr> & rmlist( removed->second );
+        for_( rmit, rmlist.begin(), rmlist.end() )
         {
           ResPair rp( *rmit, res );
 
@@ -389,7 +400,7 @@ void Summary::readPool( const ResPool & pool )
           _inst_size_remove += (*rmit)->installSize();
 
           // this turned out to be an upgrade/downgrade
-          to_be_removed[res->kind()].erase( *rmit );
+          rmlist.erase( rmit );
           upgrade_downgrade = true;
           break;
         }
@@ -412,28 +423,27 @@ void Summary::readPool( const ResPool & pool )
 
   // collect the rest (not upgraded/downgraded) of to_be_removed as '_toremove'
   // and decrease installed size change accordingly
-
-  //bool _toremove_by_solver = false;
-  for_( it, to_be_removed.begin(), to_be_removed.end() )
-    for_( resit, it->second.begin(), it->second.end() )
+  for ( const auto & ent : to_be_removed )
+    for ( const ResObject::constPtr & res : ent.second )
     {
-      /** \todo this does not work
-      if (!_toremove_by_solver)
-      {
-        PoolItem pi(*resit);
-        if (pi.status() == ResStatus::SOLVER)
-          _toremove_by_solver = true;
-      }*/
-      _toremove[it->first].insert( ResPair( nullptr, *resit ) );
-      _inst_size_remove += (*resit)->installSize();
+      _toremove[res->kind()].insert( ResPair( nullptr, res ) );
+      _inst_size_remove += res->installSize();
     }
 
-  m.elapsed();
+  m.stop();
+}
+
+// --------------------------------------------------------------------------
 
-  // *** notupdated ***
+void Summary::collectNotUpdated()
+{
+  if ( _notupdated_collected )
+    return;
+  _notupdated_collected = true;
 
   // get all available updates, no matter if they are installable or break
   // some current policy
+  const ResPool & pool( ResPool::instance() );
   KindToResPairSet candidates;
   ResKindSet kinds;
   kinds.insert( ResKind::package );
@@ -465,38 +475,27 @@ void Summary::readPool( const ResPool & pool )
       candidates[*kit].insert( ResPair( nullptr, candidate.resolvable() ) );
     }
     MIL << *kit << " update candidates: " << candidates[*kit].size() << endl;
-    MIL << "to be actually updated: " << _toupgrade[*kit].size() << endl;
   }
 
   // compare available updates with the list of packages to be upgraded
   //
-  // note: operator[] (kindToResPairSet[kind]) actually creates ResPairSet when
-  //       used. This avoids bnc #594282 which occurred when there was
-  //       for_(it, _toupgrade.begin(), _toupgrade.end()) loop used here and there
-  //       were no upgrades for that kind.
+  // note: _toupgrade must not get empty ResPairSets inserted (bnc #594282),
+  //       so we look up instead of using operator[] here.
+  static const ResPairSet noUpgrades;
   for_( kit, kinds.begin(), kinds.end() )
+  {
+    KindToResPairSet::const_iterator upgrades = _toupgrade.find( *kit );
+    const ResPairSet & toupgrade( upgrades == _toupgrade.end() ? noUpgrades : upgrades->second );
+    MIL << "to be actually updated: " << toupgrade.size() << endl;
+
+    ResPairSet notupdated;
     std::set_difference( candidates[*kit].begin(), candidates[*kit].end(),
-                         _toupgrade [*kit].begin(), _toupgrade [*kit].end(),
-                         inserter( _notupdated[*kit], _notupdated[*kit].begin() ),
+                         toupgrade.begin(), toupgrade.end(),
+                         inserter( notupdated, notupdated.begin() ),
                          Summary::ResPairNameCompare() );
-
-  // remove kinds with empty sets after the set_difference
-  for ( KindToResPairSet::iterator it = _notupdated.begin(); it != _notupdated.end(); )
-  {
-    if (it->second.empty())
-      _notupdated.erase(it++);
-    else
-      ++it;
-  }
-  for ( KindToResPairSet::iterator it = _toupgrade.begin(); it != _toupgrade.end(); )
-  {
-    if (it->second.empty())
-      _toupgrade.erase(it++);
-    else
-      ++it;
+    if ( ! notupdated.empty() )
+      _notupdated[*kit].swap( notupdated );
   }
-
-  m.stop();
 }
 
 // --------------------------------------------------------------------------
@@ -1451,6 +1450,9 @@ void Summary::writeSupportSuperseded( std::ostream & out )
 
 void Summary::writeNotUpdated( std::ostream & out )
 {
+  // lazy-compute the update candidates not to be installed
+  collectNotUpdated();
+
   for_( it, _notupdated.begin(), _notupdated.end() )
   {
     std::string label( "%d" );
@@ -1783,6 +1785,15 @@ void Summary::dumpTo( std::ostream & out )
   {
     unsetViewOption( SHOW_LOCKS );
     unsetViewOption( SHOW_NOT_UPDATED );
+
+    // Unattended quiet runs need just the counts, sizes and reboot/restart
+    // hints. Skip the weak dependency scans of all items to be installed.
+    if ( zypper.config().non_interactive )
+    {
+      MIL << "Lean summary: skip recommended and suggested items" << endl;
+      unsetViewOption( SHOW_RECOMMENDED );
+      unsetViewOption( SHOW_SUGGESTED );
+    }
   }
 
   if ( _viewop & SHOW_LOCKS )
@@ -139,6 +139,7 @@ private:
   void writeXmlResolvableList( std::ostream & out, const KindToResPairSet & resolvables );
 
   void collectInstalledRecommends( const zypp::ResObject::constPtr & obj );
+  void collectNotUpdated();
 
   bool showNeedRestartHint() const;
   bool showNeedRebootHInt() const;
@@ -173,8 +174,10 @@ private:
   KindToResPairSet _tochangevendor;
   /** Packages that have update candidate, but won't get updated.
    * In 'zypper up' this is because of vendor, repo priority, dependiencies,
-   * etc; but the list can be used also generally. */
+   * etc; but the list can be used also generally.
+   * Lazy-computed by \ref collectNotUpdated. */
   KindToResPairSet _notupdated;
+  bool _notupdated_collected;
   /** objects from previous lists with unknown support status */
   KindToResPairSet _supportUnknown;
   KindToResPairSet _supportUnsupported;	///< known to be unsupported
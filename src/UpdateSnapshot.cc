@@ -0,0 +1,158 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <unistd.h>
+
+#include <zypp/base/Logger.h>
+#include <zypp/base/String.h>
+#include <zypp/PathInfo.h>
+
+#include "UpdateSnapshot.h"
+
+using namespace zypp;
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  /// File layout (integers little endian):
+  /// \code
+  ///   "ZYSN" <u8 version> <u32 count> count * ( 5 * ( <u16 length> <bytes> ) )
+  /// \endcode
+  const char     magic[] = { 'Z', 'Y', 'S', 'N' };
+  const uint8_t  version = 1;
+
+  inline void writeUInt( std::ostream & str, uint32_t val_r, unsigned bytes_r )
+  {
+    for ( unsigned i = 0; i < bytes_r; ++i )
+      str.put( char( ( val_r >> ( 8 * i ) ) & 0xff ) );
+  }
+
+  inline bool readUInt( std::istream & str, uint32_t & val_r, unsigned bytes_r )
+  {
+    val_r = 0;
+    for ( unsigned i = 0; i < bytes_r; ++i )
+    {
+      int ch = str.get();
+      if ( ch == std::char_traits<char>::eof() )
+        return false;
+      val_r |= uint32_t( uint8_t(ch) ) << ( 8 * i );
+    }
+    return true;
+  }
+
+  inline void writeString( std::ostream & str, const std::string & val_r )
+  {
+    uint32_t len = std::min<size_t>( val_r.size(), 0xffff );
+    writeUInt( str, len, 2 );
+    str.write( val_r.data(), len );
+  }
+
+  inline bool readString( std::istream & str, std::string & val_r )
+  {
+    uint32_t len = 0;
+    if ( ! readUInt( str, len, 2 ) )
+      return false;
+    val_r.resize( len );
+    return bool( str.read( &val_r[0], len ) );
+  }
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+void UpdateSnapshot::add( const PoolItem & pi_r )
+{
+  Entry entry { pi_r.kind().asString(), pi_r.name(), pi_r.edition().asString(), pi_r.arch().asString(), pi_r.repoInfo().alias() };
+  std::string key { entry.key() };
+  _entries[std::move(key)] = std::move(entry);
+}
+
+bool UpdateSnapshot::load( const Pathname & file_r )
+{
+  _entries.clear();
+  if ( ! PathInfo( file_r ).isExist() )
+    return true;
+
+  std::ifstream in( file_r.c_str(), std::ios::binary );
+  char head[sizeof(magic)];
+  uint32_t count = 0;
+  if ( ! in.read( head, sizeof(head) ) || ! std::equal( head, head+sizeof(head), magic )
+    || in.get() != version || ! readUInt( in, count, 4 ) )
+  {
+    WAR << "Not a snapshot file: " << file_r << endl;
+    return false;
+  }
+
+  for ( uint32_t i = 0; i < count; ++i )
+  {
+    Entry entry;
+    if ( ! ( readString( in, entry.kind ) && readString( in, entry.name ) && readString( in, entry.edition )
+          && readString( in, entry.arch ) && readString( in, entry.repo ) ) )
+    {
+      WAR << "Truncated snapshot file: " << file_r << endl;
+      _entries.clear();
+      return false;
+    }
+    std::string key { entry.key() };
+    _entries[std::move(key)] = std::move(entry);
+  }
+  MIL << "Loaded " << _entries.size() << " candidates from " << file_r << endl;
+  return true;
+}
+
+bool UpdateSnapshot::save( const Pathname & file_r ) const
+{
+  const Pathname & tmpfile { file_r.extend( ".new"+str::numstring( ::getpid() ) ) };
+  {
+    std::ofstream out( tmpfile.c_str(), std::ios::binary | std::ios::trunc );
+    out.write( magic, sizeof(magic) );
+    out.put( char(version) );
+    writeUInt( out, _entries.size(), 4 );
+    for ( const auto & p : _entries )
+    {
+      const Entry & entry { p.second };
+      writeString( out, entry.kind );
+      writeString( out, entry.name );
+      writeString( out, entry.edition );
+      writeString( out, entry.arch );
+      writeString( out, entry.repo );
+    }
+    if ( ! out )
+    {
+      ERR << "Can't write snapshot " << tmpfile << endl;
+      filesystem::unlink( tmpfile );
+      return false;
+    }
+  }
+  if ( filesystem::rename( tmpfile, file_r ) != 0 )
+  {
+    filesystem::unlink( tmpfile );
+    return false;
+  }
+  return true;
+}
+
+UpdateSnapshot::Delta UpdateSnapshot::diff( const UpdateSnapshot & old_r, const UpdateSnapshot & new_r )
+{
+  Delta ret;
+  for ( const auto & p : new_r._entries )
+  {
+    auto it { old_r._entries.find( p.first ) };
+    if ( it == old_r._entries.end() )
+      ret.added.push_back( p.second );
+    else if ( it->second.edition != p.second.edition || it->second.repo != p.second.repo )
+      ret.changed.push_back( { it->second, p.second } );
+  }
+  for ( const auto & p : old_r._entries )
+  {
+    if ( ! new_r._entries.count( p.first ) )
+      ret.removed.push_back( p.second );
+  }
+  return ret;
+}
@@ -0,0 +1,78 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#ifndef ZYPPER_UPDATESNAPSHOT_H_INCLUDED
+#define ZYPPER_UPDATESNAPSHOT_H_INCLUDED
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <zypp/Pathname.h>
+#include <zypp/PoolItem.h>
+
+///////////////////////////////////////////////////////////////////
+/// \class UpdateSnapshot
+/// \brief The update candidates listed by a run of list-updates/list-patches.
+///
+/// Saved to a compact binary file (\c --since-snapshot), so the next run
+/// can report just the candidates added, removed or changed since then.
+/// Candidates are identified by kind, name and arch; a different edition
+/// or repository is a change.
+///////////////////////////////////////////////////////////////////
+class UpdateSnapshot
+{
+public:
+  struct Entry
+  {
+    std::string kind;
+    std::string name;
+    std::string edition;
+    std::string arch;
+    std::string repo;	///< repository alias
+
+    std::string key() const
+    { return kind + ":" + name + "." + arch; }
+  };
+
+  /** Candidates added, removed or changed between two snapshots. */
+  struct Delta
+  {
+    std::vector<Entry> added;
+    std::vector<Entry> removed;
+    std::vector<std::pair<Entry,Entry>> changed;	///< (old,new)
+
+    bool empty() const
+    { return added.empty() && removed.empty() && changed.empty(); }
+  };
+
+public:
+  /** Remember candidate \a pi_r. */
+  void add( const zypp::PoolItem & pi_r );
+
+  /** Number of candidates. */
+  size_t size() const
+  { return _entries.size(); }
+
+  /** Load \a file_r. A missing file is an empty snapshot.
+   * \return \c false if the file exists but is not a valid snapshot.
+   */
+  bool load( const zypp::Pathname & file_r );
+
+  /** Save to \a file_r.
+   * \return \c false if the file can't be written.
+   */
+  bool save( const zypp::Pathname & file_r ) const;
+
+  /** Changes from \a old_r to \a new_r. */
+  static Delta diff( const UpdateSnapshot & old_r, const UpdateSnapshot & new_r );
+
+private:
+  std::map<std::string,Entry> _entries;	///< by \ref Entry::key
+};
+
+#endif // ZYPPER_UPDATESNAPSHOT_H_INCLUDED
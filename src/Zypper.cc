@@ -64,6 +64,38 @@ using namespace zypp;
 
 bool sigExitOnce = true;	// Flag to prevent nested calls to Zypper::immediateExit
 
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  /** Queries which never modify the system or the repos (see zypper.conf(main/snapshotQueries)). */
+  inline bool isReadOnlyQuery( const ZypperCommand & cmd_r )
+  {
+    switch ( cmd_r.toEnum() )
+    {
+      case ZypperCommand::LIST_UPDATES_e:
+      case ZypperCommand::LIST_PATCHES_e:
+      case ZypperCommand::PATCH_CHECK_e:
+      case ZypperCommand::SEARCH_e:
+      case ZypperCommand::INFO_e:
+      case ZypperCommand::PACKAGES_e:
+      case ZypperCommand::PATCHES_e:
+      case ZypperCommand::PATTERNS_e:
+      case ZypperCommand::PRODUCTS_e:
+      case ZypperCommand::WHAT_PROVIDES_e:
+      case ZypperCommand::LIST_LOCKS_e:
+      case ZypperCommand::LICENSES_e:
+      case ZypperCommand::RUG_PATCH_INFO_e:
+      case ZypperCommand::RUG_PATTERN_INFO_e:
+      case ZypperCommand::RUG_PRODUCT_INFO_e:
+        return true;
+      default:
+        break;
+    }
+    return false;
+  }
+} // namespace
+///////////////////////////////////////////////////////////////////
+
 ZYpp::Ptr God = NULL;
 void Zypper::assertZYppPtrGod()
 {
@@ -78,6 +110,27 @@ void Zypper::assertZYppPtrGod()
   {
     ZYPP_CAUGHT (excpt_r);
 
+    // A read-only query may go on without the lock, reading the caches as they are.
+    // libzypp replaces cache files atomically, so a concurrent commit can't tear them.
+    if ( _config.snapshotQueries && isReadOnlyQuery( command() ) )
+    {
+      MIL << "ZYpp locked by " << excpt_r.lockerName() << ", reading without lock" << endl;
+      zypp_readonly_hack::IWantIt();
+      try
+      {
+        God = getZYpp();
+        _rdata.snapshot_read = true;
+        _config.no_refresh = true;
+        out().warning( str::Format(_("System management is locked by '%s'. Showing the cached repository data without refreshing it."))
+                       % excpt_r.lockerName() );
+        return;
+      }
+      catch ( const Exception & e )
+      {
+        ZYPP_CAUGHT( e );	// report the lock as usual
+      }
+    }
+
     bool still_locked = true;
     // check for packagekit (bnc #580513)
     if ( excpt_r.lockerName().find( "packagekitd" ) != std::string::npos )
@@ -736,6 +789,14 @@ void Zypper::stopCommandShell()
   _continue_running_shell = false;
 }
 
+const RepoIndex & Zypper::repoIndex()
+{
+  RepoManager & manager { repoManager() };
+  if ( ! _repoIndex || _repoIndex->size() != manager.repoSize() )
+    _repoIndex.reset( new RepoIndex( manager ) );
+  return *_repoIndex;
+}
+
 void Zypper::cleanup()
 {
   // NOTE: Via immediateExit this may be invoked from within
@@ -31,6 +31,7 @@
 #include "utils/Offering.h"
 #include "output/Out.h"
 #include "Guardians.h"
+#include "RepoIndex.h"
 
 #include "commands/basecommand.h"
 
@@ -73,6 +74,7 @@ struct RuntimeData
   , seen_verify_hint( false )
   , action_rpm_download( false )
   , entered_commit( false )
+  , snapshot_read( false )
   , tmpdir( zypp::myTmpDir() / "zypper" )
   {
     filesystem::assert_dir( tmpdir );
@@ -122,6 +124,8 @@ struct RuntimeData
 
   bool entered_commit;	// bsc#946750 - give ZYPPER_EXIT_ERR_COMMIT priority over ZYPPER_EXIT_ON_SIGNAL
 
+  bool snapshot_read;	///< running a read-only query without the zypp lock; don't write to the caches
+
   //! Temporary directory for any use, e.g. for temporary repositories.
   Pathname tmpdir;
 };
@@ -147,10 +151,17 @@ public:
   RuntimeData & runtimeData()			{ return _rdata; }
 
   void initRepoManager()
-  { _rm.reset( new RepoManager( _config.rm_options ) ); }
+  { _rm.reset( new RepoManager( _config.rm_options ) ); _repoIndex.reset(); }
 
   RepoManager & repoManager()
-  { if ( !_rm ) _rm.reset( new RepoManager( _config.rm_options ) ); return *_rm; }
+  { if ( !_rm ) { _rm.reset( new RepoManager( _config.rm_options ) ); _repoIndex.reset(); } return *_rm; }
+
+  /** Lookup index for the repos known to the \ref repoManager (rebuilt if the number of repos changed). */
+  const RepoIndex & repoIndex();
+
+  /** Rebuild the \ref repoIndex on next use (call after modifying repos). */
+  void invalidateRepoIndex()
+  { _repoIndex.reset(); }
 
   int exitInfoCode() const			{ return _exitInfoCode; }
   void setExitInfoCode( int exit )		{
@@ -249,6 +260,7 @@ private:
   RuntimeData _rdata;
 
   RepoManager_Ptr   _rm;
+  shared_ptr<RepoIndex> _repoIndex;
 };
 
 void print_unknown_command_hint( Zypper & zypper );
@@ -17,6 +17,7 @@
 #include <zypp/target/rpm/RpmDb.h>
 
 #include "Zypper.h"
+#include "PackageStore.h"
 #include "utils/prompt.h"
 #include "utils/misc.h"
 
@@ -123,6 +124,10 @@ struct DownloadResolvableReportReceiver : public callback::ReceiveReport<repo::D
     outstr.lhs << str::Format(_("In cache %1%")) % localfile_r.basename();
     fillsRhs( outstr, zypper, res_r );
     zypper.out().infoLine( outstr );
+
+    // e.g. provided by the peer cache
+    if ( res_r && PackageStore::enabled( zypper ) )
+      PackageStore( zypper ).harvest( res_r->satSolvable() );
   }
 
   /** this is interesting because we have full resolvable data at hand here
@@ -254,9 +259,15 @@ struct DownloadResolvableReportReceiver : public callback::ReceiveReport<repo::D
   }
 
   // implementation not needed prehaps - the media backend reports the download progress
-  virtual void finish( Resolvable::constPtr /*resolvable_ptr**/, Error error, const std::string & reason )
+  virtual void finish( Resolvable::constPtr resolvable_ptr, Error error, const std::string & reason )
   {
-    Zypper::instance().runtimeData().action_rpm_download = false;
+    Zypper & zypper = Zypper::instance();
+    zypper.runtimeData().action_rpm_download = false;
+
+    // Store the package while it is in the cache; unless keeppackages is set
+    // libzypp deletes it after it was installed.
+    if ( error == NO_ERROR && resolvable_ptr && PackageStore::enabled( zypper ) )
+      PackageStore( zypper ).harvest( resolvable_ptr->satSolvable() );
 /*
     display_done ("download-resolvable", cout_v);
     display_error (error, reason);
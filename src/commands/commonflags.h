@@ -8,6 +8,7 @@
 #define ZYPPER_COMMANDS_COMMONFLAGS_INCLUDED
 
 #include "utils/flags/flagtypes.h"
+#include "global-settings.h"
 
 /**
  * \file Contains all flags that are commonly used in multiple commands but which are too simple for a OptionSet
@@ -39,6 +40,22 @@ namespace CommonFlags
     };
   }
 
+  inline zypp::ZyppFlags::CommandOption sinceSnapshotFlag ( zypp::filesystem::Pathname &target ) {
+    return {
+      "since-snapshot", '\0', zypp::ZyppFlags::RequiredArgument, zypp::ZyppFlags::PathNameType( target, boost::optional<std::string>(), "FILE" ),
+      // translators: --since-snapshot <FILE>
+      _("Report only the updates added, removed or changed since the last run using the snapshot <FILE>, then update the snapshot.")
+    };
+  }
+
+  inline zypp::ZyppFlags::CommandOption xmlBriefFlag () {
+    return {
+      "brief", '\0', zypp::ZyppFlags::NoArgument, zypp::ZyppFlags::BoolType( &XmlUpdateListSettings::instanceNoConst()._brief, zypp::ZyppFlags::StoreTrue ),
+      // translators: --brief
+      _("In XML output omit the description and license of each update.")
+    };
+  }
+
   inline zypp::ZyppFlags::CommandOption updateStackOnlyFlag ( bool &targetFlag ) {
     return {
       "updatestack-only", '\0', zypp::ZyppFlags::NoArgument, zypp::ZyppFlags::BoolType( &targetFlag, zypp::ZyppFlags::StoreTrue, targetFlag ),
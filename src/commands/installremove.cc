@@ -61,7 +61,11 @@ ZyppFlags::CommandGroup InstallRemoveBase::cmdOptions() const
     CommonFlags::resKindSetFlag( that->_kinds ),
     { "name", 'n', ZyppFlags::NoArgument, ZyppFlags::BoolType( &that->_selectByName, ZyppFlags::StoreTrue, _selectByName ), _("Select packages by plain name, not by capability.") },
     { "capability", 'C', ZyppFlags::NoArgument, ZyppFlags::BoolType( &that->_selectByCap, ZyppFlags::StoreTrue, _selectByCap ), _("Select packages solely by capability.") },
-    CommonFlags::detailsFlag( that->_details )
+    CommonFlags::detailsFlag( that->_details ),
+    { "args-file", '\0', ZyppFlags::RequiredArgument, ZyppFlags::PathNameType( that->_argsFile, boost::optional<std::string>(), "FILE" ),
+      // translators: --args-file <FILE>
+      _("Read additional package arguments from <FILE>, separated by whitespace or newlines. Use '-' to read from standard input (implies --non-interactive).")
+    }
     },{
       { "capability", "name" }
     }};
@@ -73,6 +77,31 @@ void InstallRemoveBase::doReset()
   _details       = false;
   _selectByName  = false;
   _selectByCap   = false;
+  _argsFile      = zypp::Pathname();
+}
+
+bool InstallRemoveBase::readArgsFile( Zypper &zypper, std::vector<std::string> &args_r ) const
+{
+  if ( _argsFile.empty() )
+    return true;
+  if ( _argsFile == "-" && ! zypper.config().non_interactive )
+  {
+    zypper.out().info(_("Entering non-interactive mode."), Out::HIGH );
+    MIL << "Entering non-interactive mode: --args-file reads stdin" << endl;
+    zypper.configNoConst().non_interactive = true;
+  }
+  try
+  {
+    const std::vector<std::string> & fileArgs { PackageArgs::readArgsFile( _argsFile ) };
+    args_r.insert( args_r.end(), fileArgs.begin(), fileArgs.end() );
+  }
+  catch ( const Exception & e )
+  {
+    ZYPP_CAUGHT( e );
+    zypper.out().error( e.asUserString() );
+    return false;
+  }
+  return true;
 }
 
 RemoveCmd::RemoveCmd(std::vector<std::string> &&commandAliases_r) :
@@ -96,8 +125,12 @@ void RemoveCmd::doReset()
   InstallRemoveBase::doReset();
 }
 
-int RemoveCmd::execute(Zypper &zypper, const std::vector<std::string> &positionalArgs)
+int RemoveCmd::execute(Zypper &zypper, const std::vector<std::string> &positionalArgs_r)
 {
+  std::vector<std::string> positionalArgs = positionalArgs_r;
+  if ( ! readArgsFile( zypper, positionalArgs ) )
+    return ZYPPER_EXIT_ERR_INVALID_ARGS;
+
   if ( positionalArgs.size() < 1 )
   {
     zypper.out().error(
@@ -228,6 +261,13 @@ void InstallCmd::doReset()
 int InstallCmd::execute( Zypper &zypper, const std::vector<std::string> &positionalArgs_r )
 {
   std::vector<std::string> positionalArgs = positionalArgs_r;
+  if ( ! readArgsFile( zypper, positionalArgs ) )
+    return ZYPPER_EXIT_ERR_INVALID_ARGS;
+  return executeArgs( zypper, std::move(positionalArgs) );
+}
+
+int InstallCmd::executeArgs( Zypper &zypper, std::vector<std::string> positionalArgs )
+{
   if ( positionalArgs.size() < 1 && _entireCatalog.empty() )
   {
     zypper.out().error(
@@ -321,12 +361,16 @@ RemovePtfCmd::RemovePtfCmd( std::vector<std::string> &&commandAliases_r )
 int RemovePtfCmd::execute( Zypper &zypper, const std::vector<std::string> &positionalArgs_r )
 {
   static constexpr std::string_view modifiers { "+~-!" }; // explicit install/remove modifiers
+  std::vector<std::string> args = positionalArgs_r;
+  if ( ! readArgsFile( zypper, args ) )
+    return ZYPPER_EXIT_ERR_INVALID_ARGS;
+
   std::vector<std::string> positionalArgs;
-  for ( const auto & arg : positionalArgs_r ) {
+  for ( const auto & arg : args ) {
     if ( modifiers.find( arg[0] ) != std::string_view::npos )
       positionalArgs.push_back( arg );
     else
       positionalArgs.push_back( "-"+arg );
   }
-  return InstallCmd::execute( zypper, positionalArgs );
+  return InstallCmd::executeArgs( zypper, std::move(positionalArgs) );	// the modifiers apply to the file args as well
 }
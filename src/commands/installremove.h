@@ -37,6 +37,14 @@ protected:
   bool _details       = false;
   bool _selectByName  = false;
   bool _selectByCap   = false;
+  zypp::Pathname _argsFile;
+
+  /** Append the arguments read from \c --args-file to \a args_r.
+   * Reading them from stdin enters non-interactive mode, as no prompt
+   * could be answered.
+   * \return \c false (error reported) if the file can't be read.
+   */
+  bool readArgsFile( Zypper &zypper, std::vector<std::string> &args_r ) const;
 
   InitReposOptionSet _initRepos { *this };
   NoConfirmRugOption _noConfirmOpts { *this };
@@ -61,7 +69,7 @@ private:
   // ZypperBaseCommand interface
 protected:
   void doReset() override;
-  int execute(Zypper &zypper, const std::vector<std::string> &positionalArgs) override;
+  int execute(Zypper &zypper, const std::vector<std::string> &positionalArgs_r) override;
 };
 
 class InstallCmd : public InstallRemoveBase
@@ -94,6 +102,9 @@ protected:
   ZyppFlags::CommandGroup cmdOptions() const override;
   void doReset() override;
   int execute(Zypper &zypper, const std::vector<std::string> &positionalArgs_r) override;
+
+  /** \ref execute for \a args_r, the \c --args-file already appended. */
+  int executeArgs( Zypper &zypper, std::vector<std::string> args_r );
 };
 
 class RemovePtfCmd : public InstallCmd // InstallRemoveBase
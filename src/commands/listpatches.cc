@@ -29,13 +29,22 @@ zypp::ZyppFlags::CommandGroup ListPatchesCmd::cmdOptions() const
       {"all", 'a', ZyppFlags::NoArgument, ZyppFlags::BoolType( &that._all, ZyppFlags::StoreTrue, _all ),
             // translators: -a, --all
             _("List all patches, not only applicable ones.")
-      }
+      },
+      CommonFlags::sinceSnapshotFlag( that._sinceSnapshot ),
+      CommonFlags::xmlBriefFlag()
+    },{
+      // the snapshot records the patch list, not issue matches
+      { "since-snapshot", "bugzilla" },
+      { "since-snapshot", "bz" },
+      { "since-snapshot", "cve" },
+      { "since-snapshot", "issue" }
   }};
 }
 
 void ListPatchesCmd::doReset()
 {
   _all = false;
+  _sinceSnapshot = zypp::Pathname();
 }
 
 int ListPatchesCmd::execute( Zypper &zypper, const std::vector<std::string> &positionalArgs_r )
@@ -56,6 +65,8 @@ int ListPatchesCmd::execute( Zypper &zypper, const std::vector<std::string> &pos
 
     if ( _selectPatchOpts._select._requestedIssues.size() )
       list_patches_by_issue( zypper, _all, _selectPatchOpts._select );
+    else if ( ! _sinceSnapshot.empty() )
+      list_updates_since_snapshot( zypper, kinds, _all, _selectPatchOpts._select, _sinceSnapshot );
     else
       list_updates( zypper, kinds, false, _all, _selectPatchOpts._select );
 
@@ -30,10 +30,15 @@ zypp::ZyppFlags::CommandGroup ListUpdatesCmd::cmdOptions() const
   return {{
     CommonFlags::resKindSetFlag( that._kinds ),
     CommonFlags::bestEffortUpdateFlag( that._bestEffort ),
+    CommonFlags::sinceSnapshotFlag( that._sinceSnapshot ),
+    CommonFlags::xmlBriefFlag(),
     { "all", 'a', ZyppFlags::NoArgument, ZyppFlags::BoolType( &that._all, ZyppFlags::StoreTrue, _all ),
           // translators: -a, --all
           _("List all packages for which newer versions are available, regardless whether they are installable or not.")
     }
+  },{
+    // the snapshot records the regular update candidates
+    { "best-effort", "since-snapshot" }
   }};
 }
 
@@ -42,6 +47,7 @@ void ListUpdatesCmd::doReset()
   _kinds.clear();
   _all = false;
   _bestEffort = false;
+  _sinceSnapshot = zypp::Pathname();
 }
 
 int ListUpdatesCmd::execute( Zypper &zypper, const std::vector<std::string> &positionalArgs_r )
@@ -55,10 +61,19 @@ int ListUpdatesCmd::execute( Zypper &zypper, const std::vector<std::string> &pos
   if ( _kinds.empty() )
     _kinds.insert( ResKind::package );
 
-  int code = defaultSystemSetup( zypper, InitTarget | InitRepos | LoadResolvables | Resolve );
+  // Listing all package candidates just compares the highest available
+  // and the installed versions. No need to run the solver.
+  SetupSystemFlags flags = InitTarget | InitRepos | LoadResolvables;
+  if ( ! ( _all && _kinds.size() == 1 && *_kinds.begin() == ResKind::package ) )
+    flags |= Resolve;
+
+  int code = defaultSystemSetup( zypper, flags );
   if ( code != ZYPPER_EXIT_OK )
     return code;
 
-  list_updates( zypper, _kinds, _bestEffort, _all );
+  if ( ! _sinceSnapshot.empty() )
+    list_updates_since_snapshot( zypper, _kinds, _all, PatchSelector(), _sinceSnapshot );
+  else
+    list_updates( zypper, _kinds, _bestEffort, _all );
   return zypper.exitCode();
 }
@@ -51,7 +51,9 @@ int PatchCheckCmd::execute( Zypper &zypper, const std::vector<std::string> &posi
   if ( code != ZYPPER_EXIT_OK )
     return code;
 
-  // TODO calc token?
+  // unchanged input (repos, rpmdb, locks) gives an unchanged verdict
+  if ( patch_check_cached( _updateStackOnly ) )
+    return zypper.exitCode();
 
   // now load resolvables:
   code = defaultSystemSetup( zypper, LoadResolvables | Resolve );
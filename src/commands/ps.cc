@@ -9,8 +9,8 @@
 #include <iostream>
 
 #include <zypp/base/LogTools.h>
+#include <zypp/base/Xml.h>
 #include <zypp/ExternalProgram.h>
-#include <zypp/misc/CheckAccessDeleted.h>
 
 #include "Zypper.h"
 #include "Table.h"
@@ -50,6 +50,9 @@ ZyppFlags::CommandGroup PSCommand::cmdOptions() const
     }, { "debugFile", 'd', ZyppFlags::RequiredArgument, ZyppFlags::StringType(&that->_debugFile, boost::optional<const char *>(), "PATH")
             // translators: -d, --debugFile <path>
           , _("Write debug output to file <path>.")
+    }, { "units", '\0', ZyppFlags::NoArgument, ZyppFlags::BoolType( &that->_units, ZyppFlags::StoreTrue, _units )
+            // translators: --units
+          , _("Group the processes by the systemd unit they belong to and list the units which might need a restart.")
     }
   }};
 }
@@ -59,9 +62,10 @@ void PSCommand::doReset()
   _shortness = 0;
   _debugFile.clear();
   _format.clear();
+  _units = false;
 }
 
-inline void loadData( CheckAccessDeleted & checker_r )
+inline void loadData( ScanAccessDeleted & checker_r )
 {
   try
   {
@@ -73,13 +77,40 @@ inline void loadData( CheckAccessDeleted & checker_r )
   }
 }
 
-void PSCommand::printServiceNamesOnly()
+///////////////////////////////////////////////////////////////////
+namespace
 {
-  CheckAccessDeleted checker( false );	// wait for explicit call to check()
-  loadData( checker );
+  /** Processes using deleted files grouped by the systemd unit they belong to. */
+  struct RestartUnit
+  {
+    std::string slice;
+    std::vector<const ScanAccessDeleted::ProcInfo *> procs;
+    std::set<std::string> files;
+  };
+  typedef std::map<std::string,RestartUnit> RestartPlan;
+
+  RestartPlan buildRestartPlan( const ScanAccessDeleted & checker_r, bool withNonServiceProcs_r )
+  {
+    RestartPlan ret;
+    for ( const auto & procInfo : checker_r )
+    {
+      if ( ! withNonServiceProcs_r && procInfo.service().empty() )
+        continue;
+      RestartUnit & entry { ret[procInfo.unit()] };
+      if ( entry.procs.empty() )
+        entry.slice = procInfo.slice();
+      entry.procs.push_back( &procInfo );
+      entry.files.insert( procInfo.files.begin(), procInfo.files.end() );
+    }
+    return ret;
+  }
+} // namespace
+///////////////////////////////////////////////////////////////////
 
+void PSCommand::printServiceNamesOnly( const ScanAccessDeleted & checker_r )
+{
   std::set<std::string> services;
-  for ( const auto & procInfo : checker )
+  for ( const auto & procInfo : checker_r )
   {
     std::string service( procInfo.service() );
     if ( ! service.empty() )
@@ -99,6 +130,92 @@ void PSCommand::printServiceNamesOnly()
   }
 }
 
+void PSCommand::printRestartPlan( Zypper & zypper, const ScanAccessDeleted & checker_r )
+{
+  const RestartPlan & plan { buildRestartPlan( checker_r, tableWithNonServiceProcsEnabled() ) };
+
+  if ( zypper.out().type() == Out::TYPE_XML )
+  {
+    xmlout::Node parent { cout, "restart-plan", xmlout::Node::optionalContent, {
+      { "size", plan.size() },
+    } };
+    for ( const auto & entry : plan )
+    {
+      xmlout::Node unit { *parent, "unit", xmlout::Node::optionalContent, {
+        { "name", entry.first },
+        { "slice", entry.second.slice },
+      } };
+      for ( const ScanAccessDeleted::ProcInfo * procInfo : entry.second.procs )
+      {
+        xmlout::Node( *unit, "process", xmlout::Node::optionalContent, {
+          { "pid", procInfo->pid },
+          { "ppid", procInfo->ppid },
+          { "uid", procInfo->puid },
+          { "user", procInfo->login },
+          { "command", procInfo->command },
+        } );
+      }
+      for ( const std::string & file : entry.second.files )
+      { *xmlout::Node( *unit, "file" ) << xml::escape( file ); }
+    }
+    return;
+  }
+
+  if ( plan.empty() )
+  {
+    zypper.out().info(_("No processes using deleted files found.") );
+    return;
+  }
+
+  Table t;
+  bool tableWithFiles = tableWithFilesEnabled();
+  t.allowAbbrev(2);
+  {
+    TableHeader th;
+    // systemd unit (service or scope) the processes belong to
+    th << N_("Unit")
+    // systemd slice containing the unit
+    << N_("Slice")
+    // IDs of the processes in the unit using deleted files
+    << N_("PIDs");
+    if ( tableWithFiles )
+    {
+      // "list of deleted files or libraries accessed"
+      th << N_("Files");
+    }
+    t << std::move(th);
+  }
+
+  for ( const auto & entry : plan )
+  {
+    std::vector<std::string> pids;
+    for ( const ScanAccessDeleted::ProcInfo * procInfo : entry.second.procs )
+      pids.push_back( procInfo->pid );
+
+    TableRow tr;
+    tr << entry.first << entry.second.slice << str::join( pids, "," );
+
+    if ( tableWithFiles )
+    {
+      std::set<std::string>::const_iterator fit = entry.second.files.begin();
+      tr << (fit != entry.second.files.end() ? *fit : "");
+      t << std::move(tr);
+
+      for ( ++fit; fit != entry.second.files.end(); ++fit )
+      { t << ( TableRow() << "" << "" << "" << *fit ); }
+    }
+    else
+    {
+      t << std::move(tr);
+    }
+  }
+
+  zypper.out().info(_("The following systemd units contain running processes using deleted files:") );
+  cout << endl;
+  cout << t << endl;
+  zypper.out().info(_("You may wish to restart these units.") );
+}
+
 /**
  * fate #300763
  * Used by 'zypper ps' to show running processes that use
@@ -117,20 +234,28 @@ int PSCommand::execute( Zypper &zypper, const std::vector<std::string> &position
   if ( !_format.empty() )
     _shortness = 3;
 
+  // The /proc scan is done once and shared by all output modes.
+  ScanAccessDeleted checker;
+  if(debugEnabled())
+    checker.setDebugOutputFile(_debugFile);
+
   if ( printServiceNamesOnlyEnabled() ) {
     // non table output of service names only
-    printServiceNamesOnly();
+    loadData( checker );
+    printServiceNamesOnly( checker );
     return ZYPPER_EXIT_OK;
   }
 
-  // Here: Table output
   zypper.out().info(_("Checking for running processes using deleted libraries..."), Out::HIGH );
-  CheckAccessDeleted checker( false );	// wait for explicit call to check()
+  loadData( checker );
 
-  if(debugEnabled())
-    checker.setDebugOutputFile(_debugFile);
+  if ( _units ) {
+    // processes grouped by systemd unit (table or XML)
+    printRestartPlan( zypper, checker );
+    return ZYPPER_EXIT_OK;
+  }
 
-  loadData( checker );
+  // Here: Table output
 
   Table t;
   bool tableWithFiles = tableWithFilesEnabled();
@@ -205,7 +330,7 @@ int PSCommand::execute( Zypper &zypper, const std::vector<std::string> &position
   if ( geteuid() != 0 )
   {
     zypper.out().info("");
-    zypper.out().info(_("Note: Not running as root you are limited to searching for files you have permission to examine with the system stat(2) function. The result might be incomplete."));
+    zypper.out().info(_("Note: Not running as root the memory maps (/proc/<pid>/maps) and executables (/proc/<pid>/exe) of processes owned by other users can't be examined. The result might be incomplete."));
   }
   return exitCode;
 }
@@ -9,6 +9,7 @@
 
 #include "commands/basecommand.h"
 #include "utils/flags/zyppflags.h"
+#include "ScanAccessDeleted.h"
 
 class PSCommand : public ZypperBaseCommand
 {
@@ -23,7 +24,8 @@ protected:
   void doReset() override;
   int execute(Zypper &zypper, const std::vector<std::string> &positionalArgs) override;
 
-  void printServiceNamesOnly();
+  void printServiceNamesOnly( const ScanAccessDeleted & checker_r );
+  void printRestartPlan( Zypper & zypper, const ScanAccessDeleted & checker_r );
   bool tableWithFilesEnabled() const		{ return _shortness < 1; }
   bool tableWithNonServiceProcsEnabled() const	{ return _shortness < 2; }
   bool printServiceNamesOnlyEnabled() const	{ return _shortness >= 3; }
@@ -33,6 +35,7 @@ private:
   int _shortness = 0;
   std::string _format;
   std::string _debugFile;
+  bool _units = false;
 };
 
 
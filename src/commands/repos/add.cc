@@ -20,7 +20,7 @@ using namespace zypp;
 AddRepoCmd::AddRepoCmd( std::vector<std::string> &&commandAliases_r ) :
   ZypperBaseCommand(
     std::move( commandAliases_r ),
-    std::vector<std::string>{ _("addrepo (ar) [OPTIONS] <URI> <ALIAS>"), _("addrepo (ar) [OPTIONS] <FILE.repo>") },
+    std::vector<std::string>{ _("addrepo (ar) [OPTIONS] <URI> <ALIAS>"), _("addrepo (ar) [OPTIONS] <FILE.repo>"), _("addrepo (ar) [OPTIONS] --from-file <LIST>") },
     _("Add a new repository."),
     _("Add a repository to the system. The repository can be specified by its URI or can be read from specified .repo file (even remote)."),
     ResetRepoManager )
@@ -38,6 +38,12 @@ zypp::ZyppFlags::CommandGroup AddRepoCmd::cmdOptions() const
   auto that = const_cast<AddRepoCmd *>(this);
   return {{
     { "repo", 'r', ZyppFlags::RequiredArgument, ZyppFlags::StringType( &that->_repoFile, boost::optional<const char *>(), ARG_FILE_repo), _("Just another means to specify a .repo file to read.") },
+    { "from-file", '\0', ZyppFlags::RequiredArgument, ZyppFlags::PathNameType( that->_listFile, boost::optional<std::string>(), "LIST" ),
+            // translators: --from-file <LIST>
+            _("Add all repositories listed in LIST, one '<URI> <ALIAS>' per line ('-' reads stdin and implies --non-interactive). Nothing is added unless all entries are valid.") },
+    { "refresh-added", '\0', ZyppFlags::NoArgument, ZyppFlags::BoolType( &that->_refreshAdded, ZyppFlags::StoreTrue ),
+            // translators: --refresh-added
+            _("Refresh the added repositories right away. The repository type is detected and saved by the refresh instead of probing the URI before.") },
     { "check", 'c', ZyppFlags::NoArgument, ZyppFlags::BoolType( &that->_enableCheck, ZyppFlags::StoreTrue ), _("Probe URI.") },
     { "no-check", 'C', ZyppFlags::NoArgument, ZyppFlags::BoolType( &that->_disableCheck, ZyppFlags::StoreTrue ), _("Don't probe URI, probe later during refresh.") },
     { "type", 't',
@@ -50,6 +56,8 @@ zypp::ZyppFlags::CommandGroup AddRepoCmd::cmdOptions() const
 void AddRepoCmd::doReset()
 {
   _repoFile.clear();
+  _listFile = zypp::Pathname();
+  _refreshAdded = false;
   _enableCheck  = false;
   _disableCheck = false;
 }
@@ -74,10 +82,49 @@ int AddRepoCmd::execute(Zypper &zypper, const std::vector<std::string> &position
 
   try
   {
+    // add repositories listed in a file
+    if ( ! _listFile.empty() )
+    {
+      if ( ! positionalArgs_r.empty() || ! _repoFile.empty() )
+      {
+        report_too_many_arguments( zypper.out(), help() );
+        return ( ZYPPER_EXIT_ERR_INVALID_ARGS );
+      }
+
+      if ( _enableCheck )
+        zypper.configNoConst().rm_options.probe = true;
+      else if ( _disableCheck )
+        zypper.configNoConst().rm_options.probe = false;
+
+      // stdin is consumed by the list, no prompt could be answered
+      if ( _listFile == "-" && ! zypper.config().non_interactive )
+      {
+        zypper.out().info(_("Entering non-interactive mode."), Out::HIGH );
+        MIL << "Entering non-interactive mode: --from-file reads stdin" << endl;
+        zypper.configNoConst().non_interactive = true;
+      }
+
+      // load gpg keys
+      int code = defaultSystemSetup( zypper, InitTarget  );
+      if ( code != ZYPPER_EXIT_OK )
+        return code;
+
+      add_repos_from_list( zypper, _listFile, _commonProperties, _repoProperties, _disableCheck, _refreshAdded );
+      return zypper.exitCode();
+    }
+
+    // the repos are refreshed right away: load gpg keys
+    if ( _refreshAdded && ( ! _repoFile.empty() || positionalArgs_r.size() == 1 ) )
+    {
+      int code = defaultSystemSetup( zypper, InitTarget  );
+      if ( code != ZYPPER_EXIT_OK )
+        return code;
+    }
+
     // add repository specified in .repo file
     if ( ! _repoFile.empty() )
     {
-      add_repo_from_file( zypper, _repoFile, _commonProperties, _repoProperties, _disableCheck );
+      add_repo_from_file( zypper, _repoFile, _commonProperties, _repoProperties, _disableCheck, _refreshAdded );
       return zypper.exitCode();
     }
 
@@ -97,7 +144,7 @@ int AddRepoCmd::execute(Zypper &zypper, const std::vector<std::string> &position
       }
       else
       {
-        add_repo_from_file( zypper, positionalArgs_r[0], _commonProperties, _repoProperties, _disableCheck );
+        add_repo_from_file( zypper, positionalArgs_r[0], _commonProperties, _repoProperties, _disableCheck, _refreshAdded );
         break;
       }
     case 2:
@@ -121,7 +168,7 @@ int AddRepoCmd::execute(Zypper &zypper, const std::vector<std::string> &position
       if ( code != ZYPPER_EXIT_OK )
         return code;
 
-      add_repo_by_url( zypper, url, positionalArgs_r[1]/*alias*/, _commonProperties, _repoProperties, _disableCheck );
+      add_repo_by_url( zypper, url, positionalArgs_r[1]/*alias*/, _commonProperties, _repoProperties, _disableCheck, _refreshAdded );
     }
   }
   catch ( const repo::RepoUnknownTypeException & e )
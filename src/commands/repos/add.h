@@ -30,6 +30,8 @@ private:
   RepoProperties _repoProperties{*this};
   RepoServiceCommonOptions _commonProperties{OptCommandCtx::RepoContext, *this};
   std::string _repoFile;
+  zypp::Pathname _listFile;
+  bool        _refreshAdded = false;
   bool        _enableCheck  = false;
   bool        _disableCheck = false;
 };
@@ -8,7 +8,9 @@
 
 #include "commands/conditions.h"
 #include "utils/flags/flagtypes.h"
+#include "utils/flags/exceptions.h"
 #include "Zypper.h"
+#include "CacheEviction.h"
 
 CleanRepoCmd::CleanRepoCmd(std::vector<std::string> &&commandAliases_r ):
   ZypperBaseCommand(
@@ -51,7 +53,27 @@ zypp::ZyppFlags::CommandGroup CleanRepoCmd::cmdOptions() const
             ZyppFlags::BitFieldType ( that->_flags, CleanRepoBits::CleanAll),
             // translators: -a, --all
             _("Clean both metadata and package caches.")
+      },{
+        "max-size", '\0', ZyppFlags::RequiredArgument,
+            ZyppFlags::CallbackVal( [that]( const ZyppFlags::CommandOption &opt, const boost::optional<std::string> &in ) {
+              if ( ! in || ! CacheEviction::parseSize( *in, that->_maxSize ) )
+                ZYPP_THROW( ZyppFlags::InvalidValueException( opt.name, in ? *in : std::string(), _("Expected a size like 500M or 2G.") ) );
+            }, "SIZE" ),
+            // translators: --max-size <SIZE>
+            _("Evict the least recently used packages and raw metadata until the caches fit into SIZE.")
+      },{
+        "max-age", '\0', ZyppFlags::RequiredArgument,
+            ZyppFlags::CallbackVal( [that]( const ZyppFlags::CommandOption &opt, const boost::optional<std::string> &in ) {
+              if ( ! in || in->empty() || in->find_first_not_of( "0123456789" ) != std::string::npos )
+                ZYPP_THROW( ZyppFlags::InvalidValueException( opt.name, in ? *in : std::string(), _("Expected a number of days.") ) );
+              that->_maxAge = zypp::str::strtonum<unsigned>( *in );
+            }, "DAYS" ),
+            // translators: --max-age <DAYS>
+            _("Evict packages and raw metadata not used for more than DAYS days.")
       }
+    },{
+      { "max-size", "metadata" }, { "max-size", "raw-metadata" }, { "max-size", "all" },
+      { "max-age", "metadata" }, { "max-age", "raw-metadata" }, { "max-age", "all" }
   }};
 }
 
@@ -59,6 +81,8 @@ void CleanRepoCmd::doReset()
 {
   _repos.clear();
   _flags = CleanRepoBits::Default;
+  _maxSize = zypp::ByteCount();
+  _maxAge = 0;
 }
 
 int CleanRepoCmd::execute( Zypper &zypper, const std::vector<std::string> &positionalArgs_r )
@@ -68,7 +92,15 @@ int CleanRepoCmd::execute( Zypper &zypper, const std::vector<std::string> &posit
   for ( const std::string &repoFromCLI : positionalArgs_r )
     specifiedRepos.push_back(repoFromCLI);
 
-  clean_repos( zypper,  specifiedRepos, _flags );
+  if ( _maxSize || _maxAge )
+  {
+    CacheEviction::Policy policy;
+    policy.maxSize = _maxSize;
+    policy.maxAge = _maxAge;
+    evict_repo_caches( zypper, specifiedRepos, policy );
+  }
+  else
+    clean_repos( zypper,  specifiedRepos, _flags );
 
   return zypper.exitCode();
 }
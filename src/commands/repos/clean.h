@@ -13,6 +13,8 @@
 #include <string>
 #include <vector>
 
+#include <zypp/ByteCount.h>
+
 class CleanRepoCmd : public ZypperBaseCommand
 {
 public:
@@ -28,6 +30,8 @@ protected:
 private:
   std::vector<std::string> _repos;
   CleanRepoFlags _flags;
+  zypp::ByteCount _maxSize;
+  unsigned _maxAge = 0;
 };
 
 #endif
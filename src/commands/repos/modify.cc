@@ -77,20 +77,29 @@ int ModifyRepoCmd::execute(Zypper &zypper, const std::vector<std::string> &posit
   }
   else
   {
+    // Resolve all arguments before modifying anything.
+    std::vector<std::string> aliases;
+    bool notFound = false;
     for_( arg,positionalArgs_r.begin(),positionalArgs_r.end() )
     {
       RepoInfo r;
       if ( match_repo(zypper,*arg,&r) )
       {
-        modify_repo( zypper, r.alias(), _commonProps, _repoProps );
+        if ( std::find( aliases.begin(), aliases.end(), r.alias() ) == aliases.end() )
+          aliases.push_back( r.alias() );
       }
       else
       {
-       zypper.out().error( str::Format(_("Repository %s not found.")) % *arg );
+        zypper.out().error( str::Format(_("Repository %s not found.")) % *arg );
         ERR << "Repo " << *arg << " not found" << endl;
-        return ( ZYPPER_EXIT_ERR_INVALID_ARGS );
+        notFound = true;
       }
     }
+    if ( notFound )
+      return ( ZYPPER_EXIT_ERR_INVALID_ARGS );
+
+    for ( const std::string & alias : aliases )
+      modify_repo( zypper, alias, _commonProps, _repoProps );
   }
 
   return ZYPPER_EXIT_OK;
@@ -13,41 +13,49 @@
 #include "utils/messages.h"
 #include "utils/flags/flagtypes.h"
 #include "Zypper.h"
+#include "RefreshSchedule.h"
+
+#include <unordered_set>
 
 using namespace zypp;
 
 extern ZYpp::Ptr God;
 
-namespace {
-  // bsc#1234752: Try to refresh update repos first (to have updated GPG keys on the fly).
-  // GA repos usually ship the old, maybe meanwhile expired, GPG key. If such a key was
-  // prolonged, the update repo may contain it and zypp updates the trusted key on the fly
-  // when refreshing it. This avoids a 'key has expired' warning being issued when refreshing
-  // the GA repos
-  inline std::list<RepoInfo> inRefreshOrder( std::list<RepoInfo> && list_r )
-  {
-    list_r.sort( []( const RepoInfo & lhs, const RepoInfo & rhs ) {
-      static const std::string update { "update" };
-      // 'update' directory within the URS's path
-      bool lu = str::containsCI( lhs.url().getPathName(), update );
-      bool ru = str::containsCI( rhs.url().getPathName(), update );
-      if ( lu != ru )
-        return lu;      // update in path wins
-      const std::string & la { lhs.alias() };
-      const std::string & ra { rhs.alias() };
-      if ( lu )
-        return la < ra; // both update => by alias
-      // 'update' in alias or name
-      lu = str::containsCI( la, update ) || str::containsCI( lhs.name(), update );
-      ru = str::containsCI( ra, update ) || str::containsCI( rhs.name(), update );
-      if ( lu != ru )
-        return lu;    // update in alias or name wins
-      return la < ra; // finally by alias
-    } );
-    return std::move(list_r);
-  }
+// bsc#1234752: Try to refresh update repos first (to have updated GPG keys on the fly).
+// GA repos usually ship the old, maybe meanwhile expired, GPG key. If such a key was
+// prolonged, the update repo may contain it and zypp updates the trusted key on the fly
+// when refreshing it. This avoids a 'key has expired' warning being issued when refreshing
+// the GA repos
+std::list<RepoInfo> RefreshRepoCmd::inRefreshOrder( std::list<RepoInfo> && list_r )
+{
+  list_r.sort( []( const RepoInfo & lhs, const RepoInfo & rhs ) {
+    static const std::string update { "update" };
+    // 'update' directory within the URS's path
+    bool lu = str::containsCI( lhs.url().getPathName(), update );
+    bool ru = str::containsCI( rhs.url().getPathName(), update );
+    if ( lu != ru )
+      return lu;      // update in path wins
+    const std::string & la { lhs.alias() };
+    const std::string & ra { rhs.alias() };
+    if ( lu )
+      return la < ra; // both update => by alias
+    // 'update' in alias or name
+    lu = str::containsCI( la, update ) || str::containsCI( lhs.name(), update );
+    ru = str::containsCI( ra, update ) || str::containsCI( rhs.name(), update );
+    if ( lu != ru )
+      return lu;    // update in alias or name wins
+    return la < ra; // finally by alias
+  } );
+  return std::move(list_r);
+}
 
-} // namespace
+bool RefreshRepoCmd::isUpdateRepo( const RepoInfo & repo_r )
+{
+  static const std::string update { "update" };
+  return str::containsCI( repo_r.url().getPathName(), update )
+      || str::containsCI( repo_r.alias(), update )
+      || str::containsCI( repo_r.name(), update );
+}
 
 RefreshRepoCmd::RefreshRepoCmd(std::vector<std::string> &&commandAliases_r )
   : ZypperBaseCommand (
@@ -223,10 +231,14 @@ int RefreshRepoCmd::refreshRepositories( Zypper &zypper, RefreshFlags flags_r, c
       doContentCheck = true;	// keyword: need to scan all disabled repos
   }
 
+  std::unordered_set<std::string> specifiedAliases;
   std::ostringstream s;
   s << _("Specified repositories: ");
   for_( it, specified.begin(), specified.end() )
+  {
+    specifiedAliases.insert( it->alias() );
     s << it->alias() << " ";
+  }
   zypper.out().info( s.str(), Out::HIGH );
 
   unsigned error_count = 0;
@@ -242,7 +254,7 @@ int RefreshRepoCmd::refreshRepositories( Zypper &zypper, RefreshFlags flags_r, c
       {
         // enabled: Refreshed unless restricted by CLI args or mentioned in
         // --plus-content as specific repo.
-        if ( !specified.empty() && std::find( specified.begin(), specified.end(), repo ) == specified.end() )
+        if ( !specified.empty() && ! specifiedAliases.count( repo.alias() ) )
         {
           if ( plusContent.count( repo ) )
           {
@@ -270,7 +282,7 @@ int RefreshRepoCmd::refreshRepositories( Zypper &zypper, RefreshFlags flags_r, c
         }
         else
         {
-          if ( !specified.empty() && std::find( specified.begin(), specified.end(), repo ) == specified.end() )
+          if ( !specified.empty() && ! specifiedAliases.count( repo.alias() ) )
           {
             DBG << repo.alias() << "(#" << ") not specified," << " skipping." << endl;
           }
@@ -300,6 +312,9 @@ int RefreshRepoCmd::refreshRepositories( Zypper &zypper, RefreshFlags flags_r, c
   else
     enabled_repo_count = 0;
 
+  if ( RefreshSchedule::enabled( zypper ) )
+    RefreshSchedule::instance( zypper ).save();
+
   // print the result message
   if ( !not_found.empty() )
   {
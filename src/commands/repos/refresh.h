@@ -10,6 +10,7 @@
 #include "commands/basecommand.h"
 
 #include <zypp/base/Flags.h>
+#include <zypp/RepoInfo.h>
 
 class RefreshRepoCmd : public ZypperBaseCommand
 {
@@ -32,6 +33,12 @@ public:
   /** \return false on success, true on error */
   static bool refreshRepository  ( Zypper & zypper, const zypp::RepoInfo & repo, RefreshFlags flags_r = Default );
 
+  /** Sort \a list_r so update repos are refreshed first (bsc#1234752). */
+  static std::list<zypp::RepoInfo> inRefreshOrder( std::list<zypp::RepoInfo> && list_r );
+
+  /** Whether \a repo_r looks like an update repo ('update' in its URL path, alias or name). */
+  static bool isUpdateRepo( const zypp::RepoInfo & repo_r );
+
   // ZypperBaseCommand interface
 protected:
   std::vector<BaseCommandConditionPtr> conditions() const override;
@@ -128,6 +128,7 @@ bool refresh_service(Zypper & zypper, const ServiceInfo & service, RepoManager::
   {
     zypper.out().info( str::form(_("Refreshing service '%s'."), service.asUserString().c_str() ) );
     manager.refreshService( service, flags_r );
+    zypper.invalidateRepoIndex();	// the services repos may have changed
     error = false;
   }
   catch ( const repo::ServicePluginInformalException & e )
@@ -228,6 +228,7 @@ int ModifyServiceCmd::modifyService( Zypper & zypper, const std::string & alias
       || !rrtodisable.empty() )
     {
       manager.modifyService( alias, srv );
+      zypper.invalidateRepoIndex();	// the services repos may have changed
 
       if ( changed_enabled )
       {
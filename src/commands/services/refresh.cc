@@ -18,6 +18,8 @@
 #include <zypp/base/Iterator.h>
 #include <zypp/media/MediaException.h>
 
+#include <unordered_set>
+
 using namespace zypp;
 
 /**
@@ -141,9 +143,17 @@ int RefreshServicesCmd::refreshServices(Zypper &zypper, const std::vector<std::s
   get_services( zypper, services_r.begin(), services_r.end(), specified, not_found );
   report_unknown_services( zypper.out(), not_found ) ;
 
+  std::unordered_set<std::string> specifiedAliases;
+  for ( const auto & service : specified )
+    specifiedAliases.insert( service->alias() );
+
   unsigned error_count = 0;
   unsigned enabled_service_count = services.size();
 
+  // --with-repos: The repos of all services are refreshed after the services,
+  // in one pass and in refresh order (update repos first).
+  std::list<RepoInfo> serviceRepos;
+
   if ( !specified.empty() || not_found.empty() )
   {
     unsigned number = 0;
@@ -155,15 +165,7 @@ int RefreshServicesCmd::refreshServices(Zypper &zypper, const std::vector<std::s
       // skip services not specified on the command line
       if ( !specified.empty() )
       {
-        bool found = false;
-        for_( it, specified.begin(), specified.end() )
-          if ( (*it)->alias() == service_ptr->alias() )
-          {
-            found = true;
-            break;
-          }
-
-        if ( !found )
+        if ( !specifiedAliases.count( service_ptr->alias() ) )
         {
           DBG << service_ptr->alias() << "(#" << number << ") not specified," << " skipping." << endl;
           --enabled_service_count;
@@ -206,8 +208,7 @@ int RefreshServicesCmd::refreshServices(Zypper &zypper, const std::vector<std::s
           RepoManager & rm = zypper.repoManager();
           rm.getRepositoriesInService( s->alias(),
                                        make_function_output_iterator( bind( &RepoCollector::collect, &collector, _1 ) ) );
-          for_( repoit, collector.repos.begin(), collector.repos.end() )
-              RefreshRepoCmd::refreshRepository( zypper, *repoit, _force ? RefreshRepoCmd::Force : RefreshRepoCmd::Default );
+          serviceRepos.splice( serviceRepos.end(), collector.repos );
         }
       }
       else
@@ -231,6 +232,9 @@ int RefreshServicesCmd::refreshServices(Zypper &zypper, const std::vector<std::s
   else
     enabled_service_count = 0;
 
+  for ( const RepoInfo & repo : RefreshRepoCmd::inRefreshOrder( std::move(serviceRepos) ) )
+    RefreshRepoCmd::refreshRepository( zypper, repo, _force ? RefreshRepoCmd::Force : RefreshRepoCmd::Default );
+
   // print the result message
   if ( enabled_service_count == 0 )
   {
@@ -6,6 +6,7 @@
 \*---------------------------------------------------------------------------*/
 
 #include <iostream>
+#include <optional>
 
 #include <zypp/base/LogTools.h>
 #include <zypp/Package.h>
@@ -20,6 +21,8 @@
 #include "utils/messages.h"
 #include "Zypper.h"
 #include "PackageArgs.h"
+#include "PackageStore.h"
+#include "PeerCache.h"
 #include "Table.h"
 #include "download.h"
 #include "global-settings.h"
@@ -276,6 +279,16 @@ int DownloadCmd::execute( Zypper &zypper , const std::vector<std::string> &posit
     // Prepare the package cache. Pass all items requiring download.
     target::CommitPackageCache packageCache;
 
+    // Packages downloaded for other repos are taken from the shared store.
+    std::optional<PackageStore> packageStore;
+    if ( PackageStore::enabled( zypper ) && !DryRunSettings::instance().isEnabled() )
+      packageStore.emplace( zypper );
+
+    // Packages not yet cached are first asked from the peer cache.
+    std::optional<PeerCache> peerCache;
+    if ( PeerCache::enabled( zypper ) && !DryRunSettings::instance().isEnabled() )
+      peerCache.emplace( zypper );
+
     unsigned current = 0;
     zypper.runtimeData().commit_pkgs_total = total; // fix DownloadResolvableReport total counter
     for ( const auto & ent : collect )
@@ -284,6 +297,11 @@ int DownloadCmd::execute( Zypper &zypper , const std::vector<std::string> &posit
       {
         ++current;
 
+        if ( packageStore )
+          packageStore->adopt( pi.satSolvable() );
+        if ( peerCache )
+          peerCache->fetch( pi.satSolvable() );
+
         if ( ! isCached( pi ) )
         {
           if ( !DryRunSettings::instance().isEnabled() )
@@ -317,6 +335,8 @@ int DownloadCmd::execute( Zypper &zypper , const std::vector<std::string> &posit
 
             //DBG << localfile << endl;
             localfile.resetDispose();
+            if ( packageStore && ! localfile.value().empty() )
+              packageStore->harvest( pi.satSolvable() );
             if ( zypper.out().typeXML() )
               logXmlResult( pi, localfile );
 
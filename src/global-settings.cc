@@ -14,6 +14,7 @@ void GlobalSettings::reset()
   LicenseAgreementPolicy::reset();
   DupSettings::reset();
   FileConflictPolicy::reset();
+  XmlUpdateListSettings::reset();
 }
 
 bool LicenseAgreementPolicyData::_defaultAutoAgreeWithLicenses = false;
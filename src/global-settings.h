@@ -98,6 +98,15 @@ struct FileConflictPolicyData
 };
 using FileConflictPolicy = GlobalSettingSingleton<FileConflictPolicyData>;
 
+/**
+ * XML output of list-updates/list-patches
+ */
+struct XmlUpdateListSettingsData
+{
+  bool _brief = false;	///< omit the heavy fields (description, license)
+};
+using XmlUpdateListSettings = GlobalSettingSingleton<XmlUpdateListSettingsData>;
+
 
 
 #endif
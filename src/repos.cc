@@ -9,12 +9,16 @@
 #include <fstream>
 #include <iterator>
 #include <list>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <zypp/ZYpp.h>
 #include <zypp/base/Logger.h>
 #include <zypp/base/IOStream.h>
 #include <zypp/base/String.h>
 #include <zypp/base/Flags.h>
+#include <zypp/PathInfo.h>
 
 #include <zypp/RepoManager.h>
 #include <zypp/repo/RepoException.h>
@@ -31,6 +35,9 @@
 #include "utils/prompt.h"
 #include "repos.h"
 #include "global-settings.h"
+#include "MetadataCheckpoint.h"
+#include "RefreshSchedule.h"
+#include "SolvFingerprint.h"
 
 #include "commands/services/common.h"
 #include "commands/repos/refresh.h"
@@ -213,6 +220,12 @@ bool refresh_raw_metadata( Zypper & zypper, const RepoInfo & repo, bool force_do
 
   RepoManager & manager = zypper.repoManager();
 
+  // remember the check for the RefreshSchedule
+  bool checked = force_download;
+  RepoStatus oldStatus;
+  if ( RefreshSchedule::enabled( zypper ) )
+    oldStatus = manager.metadataStatus( repo );
+
   // bsc#1123967
   // Temporarily disconnect, if errors happen we just skip the repository
 #define DISABLE_ScopedDisableMediaChangeReport_GUARD
@@ -245,6 +258,7 @@ bool refresh_raw_metadata( Zypper & zypper, const RepoInfo & repo, bool force_do
                     RepoManager::RefreshIfNeeded );
 
             do_refresh = ( stat == RepoManager::REFRESH_NEEDED );
+            checked = ( stat != RepoManager::REPO_CHECK_DELAYED );
             if ( !do_refresh
               && ( zypper.command() == ZypperCommand::REFRESH || zypper.command() == ZypperCommand::REFRESH_SERVICES ) )
             {
@@ -287,6 +301,14 @@ bool refresh_raw_metadata( Zypper & zypper, const RepoInfo & repo, bool force_do
 
     if ( do_refresh )
     {
+      // Download the files one by one first, so an interrupted refresh can resume.
+      if ( MetadataCheckpoint::enabled( zypper ) )
+      {
+        MetadataCheckpoint checkpoint( zypper, repo );
+        if ( checkpoint.applicable() )
+          checkpoint.fetch();
+      }
+
       plabel = str::form(_("Retrieving repository '%s' metadata"), repo.asUserString().c_str() );
       zypper.out().progressStart( "raw-refresh", plabel, true );
 
@@ -299,6 +321,9 @@ bool refresh_raw_metadata( Zypper & zypper, const RepoInfo & repo, bool force_do
       zypper.out().progressEnd( "raw-refresh", plabel );
       plabel.clear();
     }
+
+    if ( checked && RefreshSchedule::enabled( zypper ) )
+      RefreshSchedule::instance( zypper ).checked( repo, do_refresh && manager.metadataStatus( repo ).checksum() != oldStatus.checksum() );
   }
   catch ( const AbortRequestException & e )
   {
@@ -323,6 +348,7 @@ bool refresh_raw_metadata( Zypper & zypper, const RepoInfo & repo, bool force_do
 
         origRepo.setEnabled( false );
         manager.modifyRepository (repo.alias(), origRepo );
+        zypper.invalidateRepoIndex();
       }
       catch ( const Exception & ex )
       {
@@ -418,9 +444,22 @@ bool build_cache( Zypper & zypper, const RepoInfo & repo, bool force_build )
   try
   {
     RepoManager & manager = zypper.repoManager();
+
+    // Don't rebuild the solv file if the data it is built from did not change.
+    std::optional<SolvFingerprint> fingerprint;
+    if ( SolvFingerprint::enabled( zypper ) )
+    {
+      fingerprint.emplace( zypper, repo );
+      if ( !force_build )
+        fingerprint->keepUnchanged();
+    }
+
     manager.buildCache(repo, force_build ?
       RepoManager::BuildForced : RepoManager::BuildIfNeeded);
 
+    if ( fingerprint )
+      fingerprint->save();
+
     // Also load the solv file to check whether it was created with the right
     // version of satsolver-tools. If there's a version mismatch or some other
     // problem, the solv file will be rebuilt even though the cookie files
@@ -467,8 +506,6 @@ bool build_cache( Zypper & zypper, const RepoInfo & repo, bool force_build )
 
 bool match_repo( Zypper & zypper, std::string str, RepoInfo *repo, bool looseQuery_r, bool looseAuth_r )
 {
-  RepoManager & manager( zypper.repoManager() );
-
   if ( ! zypper.runtimeData().temporary_repos.empty() )
   {
     // Quick check for temporary_repos (alias only)
@@ -483,102 +520,25 @@ bool match_repo( Zypper & zypper, std::string str, RepoInfo *repo, bool looseQue
     }
   }
 
+  const RepoIndex & index( zypper.repoIndex() );
+
   // Quick check for alias/reponumber/name first.
   // Name can be ambiguous, in which case the first match found will be returned
-  {
-    unsigned number = 1; // repo number
-    unsigned tmp    = 0;
-    safe_lexical_cast( str, tmp ); // try to make an int out of the string
-    for ( RepoManager::RepoConstIterator known_it = manager.repoBegin(); known_it != manager.repoEnd(); ++known_it, ++number )
-    {
-      if ( known_it->alias() == str || tmp == number || known_it->name() == str )
-      {
-        if ( repo )
-          *repo = *known_it;
-        return true;
-      }
-    }
-  }
+  const RepoInfo * found = index.find( str );
 
-  // expensive URL analysis only if the above did not find anything.
+  // URL analysis only if the above did not find anything.
   // URL can be ambiguous, in which case the first found match will be returned.
-  bool found = false;
-  try
+  if ( ! found )
   {
-    Url strurl( str );	// no need to continue if str is no Url.
-
-    for ( RepoManager::RepoConstIterator known_it = manager.repoBegin(); known_it != manager.repoEnd(); ++known_it )
+    try
     {
-      try
-      {
-        // first strip any trailing slash from the path in URLs before comparing
-        // (bnc #585082)
-        // we can afford this because we expect that the repo urls are directories
-        // and it is common practice in servers and operating systems to accept
-        // directory paths both with and without trailing slashes.
-        Url uurl( strurl );
-        uurl.setPathName( Pathname(uurl.getPathName()).asString() );
-
-        url::ViewOption urlview =
-        url::ViewOption::DEFAULTS + url::ViewOption::WITH_PASSWORD;
-        if ( looseAuth_r ) // ( zypper.cOpts().count("loose-auth") )
-        {
-          urlview = urlview
-          - url::ViewOptions::WITH_PASSWORD
-          - url::ViewOptions::WITH_USERNAME;
-        }
-        if ( looseQuery_r ) // ( zypper.cOpts().count("loose-query") )
-          urlview = urlview - url::ViewOptions::WITH_QUERY_STR;
-
-        // need to do asString(withurlview) comparison here because the user-given
-        // string is expected to have no credentials or query
-        if ( !( urlview.has( url::ViewOptions::WITH_PASSWORD ) && urlview.has( url::ViewOptions::WITH_QUERY_STR ) ) )
-        {
-          if ( !known_it->baseUrlsEmpty() )
-          {
-            for_( urlit, known_it->baseUrlsBegin(), known_it->baseUrlsEnd() )
-            {
-              Url newrl( *urlit );
-              newrl.setPathName( Pathname(newrl.getPathName()).asString() );
-              if ( newrl.asString(urlview) == uurl.asString(urlview) )
-              {
-                found = true;
-                break;
-              }
-            }
-          }
-        }
-        // ordinary == comparison suffices here (quicker)
-        else
-        {
-          if ( !known_it->baseUrlsEmpty() )
-          {
-            for_( urlit, known_it->baseUrlsBegin(), known_it->baseUrlsEnd() )
-            {
-              Url newrl( *urlit );
-              newrl.setPathName( Pathname(newrl.getPathName()).asString() );
-              if ( newrl == uurl )
-              {
-                found = true;
-                break;
-              }
-            }
-          }
-        }
-
-        if ( found )
-        {
-          if ( repo )
-            *repo = *known_it;
-          break;
-        }
-      }
-      catch ( const url::UrlException & ) {}
-
-    } // END for all known repos
+      found = index.findUrl( Url( str ), looseQuery_r, looseAuth_r );
+    }
+    catch ( const url::UrlException & ) {}	// no need to continue if str is no Url.
   }
-  catch ( const url::UrlException & ) {}
 
+  if ( found && repo )
+    *repo = *found;
   return found;
 }
 
@@ -628,6 +588,11 @@ bool repo_cmp_alias_urls(const RepoInfo &lhs, const RepoInfo &rhs)
 template<typename T>
 void get_repos( Zypper & zypper, const T & begin, const T & end, std::list<RepoInfo> & repos, std::list<std::string> & not_found )
 {
+  // Repos found so far by alias. A duplicate must also have the same URIs.
+  std::unordered_multimap<std::string,const RepoInfo *> seen;
+  for ( const RepoInfo & repo : repos )
+    seen.emplace( repo.alias(), &repo );
+
   for ( T it = begin; it != end; ++it )
   {
     RepoInfo repo;
@@ -640,11 +605,11 @@ void get_repos( Zypper & zypper, const T & begin, const T & end, std::list<RepoI
 
     // repo found
     // is it a duplicate? compare by alias and URIs
-    //! \todo operator== in RepoInfo?
     bool duplicate = false;
-    for_( repo_it, repos.begin(), repos.end() )
+    auto range = seen.equal_range( repo.alias() );
+    for ( auto sit = range.first; sit != range.second; ++sit )
     {
-      if ( repo_cmp_alias_urls( repo, *repo_it ) )
+      if ( repo_cmp_alias_urls( repo, *sit->second ) )
       {
         duplicate = true;
         break;
@@ -652,7 +617,10 @@ void get_repos( Zypper & zypper, const T & begin, const T & end, std::list<RepoI
     } // END for all found so far
 
     if ( !duplicate )
+    {
       repos.push_back( repo );
+      seen.emplace( repo.alias(), &repos.back() );
+    }
   }
 }
 
@@ -847,6 +815,11 @@ void do_init_repos( Zypper & zypper )
 
 
     bool do_refresh = repo.enabled() && repo.autorefresh() && !zypper.config().no_refresh;
+    if ( do_refresh && RefreshSchedule::enabled( zypper ) && ! RefreshSchedule::instance( zypper ).due( repo ) )
+    {
+      MIL << "refresh schedule says not to check " << repo.alias() << " yet" << endl;
+      do_refresh = false;	// just build the cache below
+    }
     if ( do_refresh )
     {
       MIL << "calling refresh for " << repo.alias() << endl;
@@ -887,8 +860,8 @@ void do_init_repos( Zypper & zypper )
       }
     }
     // even if refresh is not required, try to build the cache
-    // for the case of non-existing cache
-    else if ( repo.enabled() )
+    // for the case of non-existing cache (but use the caches as they are without the zypp lock)
+    else if ( repo.enabled() && ! gData.snapshot_read )
     {
       if ( build_cache( zypper, repo, false ) )
       {
@@ -941,6 +914,9 @@ void do_init_repos( Zypper & zypper )
     // zypper.setExitCode( ZYPPER_EXIT_ERR_ZYPP );
     zypper.setExitInfoCode( ZYPPER_EXIT_INF_REPOS_SKIPPED );
   }
+
+  if ( RefreshSchedule::enabled( zypper ) )
+    RefreshSchedule::instance( zypper ).save();
 }
 
 // ----------------------------------------------------------------------------
@@ -1011,10 +987,14 @@ void clean_repos(Zypper & zypper , std::vector<std::string> specificRepos, Clean
   get_repos( zypper, specificRepos.begin(), specificRepos.end(), specified, not_found );
   report_unknown_repos( zypper.out(), not_found );
 
+  std::unordered_set<std::string> specifiedAliases;
   std::ostringstream s;
   s << _("Specified repositories: ");
   for_( it, specified.begin(), specified.end() )
+  {
+    specifiedAliases.insert( it->alias() );
     s << it->alias() << " ";
+  }
   zypper.out().info( s.str(), Out::HIGH );
 
   // should we clean packages or metadata ?
@@ -1040,15 +1020,9 @@ void clean_repos(Zypper & zypper , std::vector<std::string> specificRepos, Clean
 
       if ( !specified.empty() )
       {
-        bool found = false;
-        for_( it, specified.begin(), specified.end() )
-          if ( it->alias() == repo.alias() )
-          {
-            explicitelySpecified = found = true;
-            break;
-          }
+        explicitelySpecified = specifiedAliases.count( repo.alias() );
 
-        if ( !found )
+        if ( !explicitelySpecified )
         {
           DBG << repo.alias() << "(#" << ") not specified," << " skipping." << endl;
           enabled_repo_count--;
@@ -1143,6 +1117,36 @@ void clean_repos(Zypper & zypper , std::vector<std::string> specificRepos, Clean
     zypper.out().info(_("All repositories have been cleaned up.") );
 }
 
+void evict_repo_caches( Zypper & zypper, std::vector<std::string> specificRepos, const CacheEviction::Policy & policy )
+{
+  CacheEviction eviction( zypper );
+
+  if ( ! specificRepos.empty() )
+  {
+    std::list<RepoInfo> specified;
+    std::list<std::string> not_found;
+    get_repos( zypper, specificRepos.begin(), specificRepos.end(), specified, not_found );
+    report_unknown_repos( zypper.out(), not_found );
+    if ( specified.empty() )
+    {
+      zypper.setExitCode( ZYPPER_EXIT_ERR_INVALID_ARGS );
+      return;
+    }
+    eviction.restrictTo( specified );
+  }
+
+  const CacheEviction::Result & result { eviction.evict( policy ) };
+  if ( result.freed )
+  {
+    // translators: %1% is a size like '1.2 GiB'
+    zypper.out().info( str::Format(_("Freed %1% of cached packages and metadata.")) % result.freed );
+    zypper.out().info( str::Format(_("Evicted %1% packages and %2% raw metadata caches, %3% remaining."))
+                       % result.packages % result.metadata % ByteCount( result.size - result.freed ), Out::HIGH );
+  }
+  else
+    zypper.out().info( str::Format(_("The caches (%1%) need no cleanup.")) % result.size );
+}
+
 // ----------------------------------------------------------------------------
 
 bool add_repo( Zypper & zypper, RepoInfo & repo, bool noCheck )
@@ -1285,40 +1289,241 @@ bool add_repo( Zypper & zypper, RepoInfo & repo, bool noCheck )
 }
 
 // ----------------------------------------------------------------------------
+
+namespace
+{
+  /** The RepoInfo for a new repo at \a url (options applied). */
+  RepoInfo repo_for_url( const Url & url,
+                         const std::string & alias,
+                         const RepoServiceCommonOptions &opts,
+                         const RepoProperties &repoProps )
+  {
+    RepoInfo repo;
+
+    repo.setAlias( alias.empty() ? timestamp() : alias );
+
+    repo.addBaseUrl( url );
+
+    if ( !opts._name.empty() )
+      repo.setName( opts._name );
+
+    repo.setEnabled( indeterminate( opts._enable ) ? true : bool(opts._enable) );
+    repo.setAutorefresh( indeterminate( opts._enableAutoRefresh ) ? false : bool( opts._enableAutoRefresh ) );	// wouldn't true be the better default?
+
+    if ( repoProps._priority >= 1 )
+      repo.setPriority( repoProps._priority );
+
+    if ( !indeterminate( repoProps._keepPackages ) )
+      repo.setKeepPackages( bool(repoProps._keepPackages) );
+
+    RepoInfo::GpgCheck gpgCheck = repoProps._gpgCheck;
+    if ( gpgCheck != RepoInfo::GpgCheck::indeterminate )
+      repo.setGpgCheck( gpgCheck );
+
+    return repo;
+  }
+
+  /** Repos added to be refreshed right away are probed by the refresh.
+   * The detected type is saved afterwards (\ref save_detected_type).
+   */
+  void defer_probe( Zypper & zypper )
+  {
+    if ( zypper.config().rm_options.probe )
+    {
+      MIL << "Deferring the probe to the refresh" << endl;
+      zypper.configNoConst().rm_options.probe = false;
+      zypper.initRepoManager();
+    }
+  }
+
+  /** libzypp probes an untyped repo on each refresh but does not remember
+   * the result. Save the type of the metadata \a repo_r refresh downloaded,
+   * so later refreshes don't need to probe again.
+   */
+  void save_detected_type( Zypper & zypper, RepoInfo & repo_r )
+  {
+    if ( repo_r.type() != repo::RepoType::NONE )
+      return;
+
+    const Pathname & rawdir { zypper.repoManager().metadataPath( repo_r ) };
+    repo::RepoType type;
+    if ( PathInfo( rawdir / "repodata/repomd.xml" ).isFile() )
+      type = repo::RepoType::RPMMD;
+    else if ( PathInfo( rawdir / "content" ).isFile() )
+      type = repo::RepoType::YAST2;
+    else
+      return;	// e.g. plaindir; probing a local dir is cheap anyway
+
+    try
+    {
+      repo_r.setType( type );
+      zypper.repoManager().modifyRepository( repo_r.alias(), repo_r );
+      zypper.invalidateRepoIndex();
+      MIL << "Saved detected type " << type << " of " << repo_r.alias() << endl;
+    }
+    catch ( const Exception & e )
+    {
+      ZYPP_CAUGHT( e );
+      WAR << "Can't save the type of " << repo_r.alias() << endl;
+    }
+  }
+
+  /** Refresh the just \a added repos in one pass. Unless \a noCheck, repos
+   * whose metadata can't be downloaded are removed again, just as a failed
+   * probe would not have added them.
+   */
+  void refresh_added_repos( Zypper & zypper, std::list<RepoInfo> && added, bool noCheck )
+  {
+    for ( RepoInfo & repo : RefreshRepoCmd::inRefreshOrder( std::move(added) ) )
+    {
+      if ( ! repo.enabled() )
+        continue;
+
+      if ( refresh_raw_metadata( zypper, repo, false ) )
+      {
+        if ( ! noCheck )
+        {
+          zypper.out().error( str::Format(_("Can't find a valid repository at '%s', removing '%s' again.")) % repo.url().asString() % repo.asUserString() );
+          remove_repo( zypper, repo );
+        }
+        zypper.setExitCode( ZYPPER_EXIT_ERR_ZYPP );
+        continue;
+      }
+
+      save_detected_type( zypper, repo );
+      if ( build_cache( zypper, repo, false ) )
+        zypper.setExitCode( ZYPPER_EXIT_ERR_ZYPP );
+    }
+    if ( RefreshSchedule::enabled( zypper ) )
+      RefreshSchedule::instance( zypper ).save();
+  }
+} // namespace
+
 /// \todo merge common code with add_repo_from_file
 void add_repo_by_url( Zypper & zypper,
                       const Url & url,
                       const std::string & alias,
                       const RepoServiceCommonOptions &opts,
                       const RepoProperties &repoProps,
-                      bool noCheck )
+                      bool noCheck,
+                      bool refresh )
 {
   MIL << "going to add repository by url (alias=" << alias << ", url=" << url << ")" << endl;
 
-  RepoInfo repo;
+  if ( refresh )
+    defer_probe( zypper );
 
-  repo.setAlias( alias.empty() ? timestamp() : alias );
+  RepoInfo repo { repo_for_url( url, alias, opts, repoProps ) };
+  if ( add_repo( zypper, repo, noCheck ) )
+  {
+    repoPrioSummary( zypper );
+    if ( refresh )
+      refresh_added_repos( zypper, { repo }, noCheck );
+  }
+}
 
-  repo.addBaseUrl( url );
+// ----------------------------------------------------------------------------
 
-  if ( !opts._name.empty() )
-    repo.setName( opts._name );
+void add_repos_from_list( Zypper & zypper,
+                          const Pathname & list_file,
+                          const RepoServiceCommonOptions &opts,
+                          const RepoProperties &repoProps,
+                          bool noCheck,
+                          bool refresh )
+{
+  std::ifstream infile;
+  if ( list_file != "-" )
+  {
+    infile.open( list_file.c_str() );
+    if ( ! infile )
+    {
+      zypper.out().error( str::Format(_("Can't read %1%")) % list_file );
+      zypper.setExitCode( ZYPPER_EXIT_ERR_INVALID_ARGS );
+      return;
+    }
+  }
+  std::istream & in { list_file == "-" ? std::cin : infile };
 
-  repo.setEnabled( indeterminate( opts._enable ) ? true : bool(opts._enable) );
-  repo.setAutorefresh( indeterminate( opts._enableAutoRefresh ) ? false : bool( opts._enableAutoRefresh ) );	// wouldn't true be the better default?
+  // Validate all entries before adding anything.
+  RepoManager & manager( zypper.repoManager() );
+  std::list<RepoInfo> toAdd;
+  std::unordered_set<std::string> aliases;
+  unsigned errors = 0;
+  auto reportError = [&]( unsigned lineno, const std::string & msg ) {
+    zypper.out().error( str::Format("%1%:%2%: %3%") % list_file % lineno % msg );
+    ++errors;
+  };
+
+  for ( iostr::EachLine line( in ); line; line.next() )
+  {
+    std::string l { *line };
+    std::string::size_type pos = l.find( '#' );
+    if ( pos != std::string::npos )
+      l.erase( pos );
+    std::vector<std::string> words;
+    str::split( l, std::back_inserter(words) );
+    if ( words.empty() )
+      continue;
 
-  if ( repoProps._priority >= 1 )
-    repo.setPriority( repoProps._priority );
+    unsigned lineno = line.lineNo();
+    if ( words.size() != 2 )
+    {
+      reportError( lineno, _("Expected a URI and an alias.") );
+      continue;
+    }
 
-  if ( !indeterminate( repoProps._keepPackages ) )
-    repo.setKeepPackages( bool(repoProps._keepPackages) );
+    const std::string & alias { words[1] };
+    if ( alias[0] == '.' || alias.find( '/' ) != std::string::npos )
+    {
+      reportError( lineno, str::Format(_("Invalid repository alias: '%s'")) % alias );
+      continue;
+    }
+    if ( ! aliases.insert( alias ).second )
+    {
+      reportError( lineno, str::Format(_("Alias '%s' is used more than once.")) % alias );
+      continue;
+    }
+    if ( manager.hasRepo( alias ) )
+    {
+      reportError( lineno, str::Format(_("Repository named '%s' already exists. Please use another alias.")) % alias );
+      continue;
+    }
 
-  RepoInfo::GpgCheck gpgCheck = repoProps._gpgCheck;
-  if ( gpgCheck != RepoInfo::GpgCheck::indeterminate )
-    repo.setGpgCheck( gpgCheck );
+    Url url { words[0].find( "obs:" ) == 0 ? make_obs_url( words[0] ) : make_url( words[0] ) };
+    if ( ! url.isValid() )
+    {
+      reportError( lineno, str::Format(_("Invalid URI '%s'.")) % words[0] );
+      continue;
+    }
 
-  if ( add_repo( zypper, repo, noCheck ) )
-    repoPrioSummary( zypper );
+    toAdd.push_back( repo_for_url( url, alias, opts, repoProps ) );
+  }
+
+  if ( errors )
+  {
+    zypper.out().error( str::Format(PL_("%1% invalid entry in %2%, no repository added.",
+                                        "%1% invalid entries in %2%, no repository added.", errors )) % errors % list_file );
+    zypper.setExitCode( ZYPPER_EXIT_ERR_INVALID_ARGS );
+    return;
+  }
+  MIL << "Adding " << toAdd.size() << " repos from " << list_file << endl;
+
+  if ( refresh )
+    defer_probe( zypper );
+
+  std::list<RepoInfo> added;
+  for ( RepoInfo & repo : toAdd )
+  {
+    if ( add_repo( zypper, repo, noCheck ) )
+      added.push_back( repo );
+  }
+  if ( added.empty() )
+    return;
+
+  repoPrioSummary( zypper );
+
+  if ( refresh )
+    refresh_added_repos( zypper, std::move(added), noCheck );
 }
 
 // ----------------------------------------------------------------------------
@@ -1327,7 +1532,8 @@ void add_repo_from_file( Zypper & zypper,
                          const std::string & repo_file_url,
                          const RepoServiceCommonOptions &opts,
                          const RepoProperties &repoProps,
-                         bool noCheck )
+                         bool noCheck,
+                         bool refresh )
 {
   Url url = make_url( repo_file_url );
   if ( !url.isValid() )
@@ -1368,8 +1574,11 @@ void add_repo_from_file( Zypper & zypper,
     return;
   }
 
+  if ( refresh )
+    defer_probe( zypper );
+
   // add repos
-  bool addedAtLeastOneRepository = false;
+  std::list<RepoInfo> added;
   for_( rit, repos.begin(), repos.end() )
   {
     RepoInfo & repo( *rit );
@@ -1405,11 +1614,15 @@ void add_repo_from_file( Zypper & zypper,
       repo.setPriority( repoProps._priority );
 
     if ( add_repo( zypper, repo, noCheck ) )
-      addedAtLeastOneRepository = true;
+      added.push_back( repo );
   }
 
-  if ( addedAtLeastOneRepository )
+  if ( ! added.empty() )
+  {
     repoPrioSummary( zypper );
+    if ( refresh )
+      refresh_added_repos( zypper, std::move(added), noCheck );
+  }
   return;
 }
 
@@ -1605,6 +1818,7 @@ void modify_repo( Zypper & zypper, const std::string & alias, const RepoServiceC
       bool didVolatileChanges = false;
 
       manager.modifyRepository( alias, repo );
+      zypper.invalidateRepoIndex();
 
       if ( changed_enabled )
       {
@@ -1778,8 +1992,8 @@ void load_repo_resolvables( Zypper & zypper )
     {
       bool error = false;
 
-      // if there is no metadata locally
-      if ( manager.metadataStatus(repo).empty() )
+      // if there is no metadata locally (without the zypp lock just load the cache as it is)
+      if ( ! gData.snapshot_read && manager.metadataStatus(repo).empty() )
       {
         if ( geteuid() == 0 ) {
           zypper.out().info( str::Format(_("Retrieving repository '%s' data...")) % repo.name() );
@@ -1788,7 +2002,7 @@ void load_repo_resolvables( Zypper & zypper )
         // else: as non-root user we'll see whether a usable solv cache exists ....
       }
 
-      if ( !error && !manager.isCached(repo) )
+      if ( !error && ! gData.snapshot_read && !manager.isCached(repo) )
       {
         zypper.out().info( str::Format(_("Repository '%s' not cached. Caching...")) % repo.name() );
         error = build_cache( zypper, repo, false );
@@ -1818,6 +2032,8 @@ void load_repo_resolvables( Zypper & zypper )
       // index is sometimes slow, so we avoid this overhead by directly accessing
       // the sat::Pool.
       Repository robj = sat::Pool::instance().reposFind( repo.alias() );
+      if ( robj != Repository::noRepository && RefreshSchedule::enabled( zypper ) )
+        RefreshSchedule::instance( zypper ).expires( repo, robj.suggestedExpirationTimestamp() );
       if ( robj != Repository::noRepository && robj.maybeOutdated() )
       {
         zypper.out().warning( str::Format(_("Repository '%1%' metadata expired since %2%."))
@@ -1836,6 +2052,8 @@ void load_repo_resolvables( Zypper & zypper )
       zypper.out().info( str::Format(_("Resolvables from '%s' not loaded because of error.")) % repo.asUserString() );
     }
   }
+  if ( RefreshSchedule::enabled( zypper ) )
+    RefreshSchedule::instance( zypper ).save();
   if ( hintExpired ) {
     Zypper::instance().out().warningPar( 4, _("Repository metadata expired: "
     "Check if 'autorefresh' is turned on (zypper lr), otherwise manually refresh the repository (zypper ref). "
@@ -18,6 +18,7 @@
 #include <zypp/ServiceInfo.h>
 
 #include "Zypper.h"
+#include "CacheEviction.h"
 #include "commands/reposerviceoptionsets.h"
 
 #define  TMP_RPM_REPO_ALIAS  "_tmpRPMcache_"
@@ -106,6 +107,11 @@ enum class CleanRepoBits {
 ZYPP_DECLARE_FLAGS_AND_OPERATORS(CleanRepoFlags, CleanRepoBits)
 void clean_repos(Zypper & zypper, std::vector<std::string> specificRepos, CleanRepoFlags flags );
 
+/**
+ * Evict LRU packages and raw metadata of all (specified) repositories according to \a policy.
+ */
+void evict_repo_caches( Zypper & zypper, std::vector<std::string> specificRepos, const CacheEviction::Policy & policy );
+
 /**
  * Try match given string with any known repository.
  *
@@ -129,7 +135,7 @@ void add_repo_by_url(Zypper & zypper,
                       const Url & url,
                       const std::string & alias,
                       const RepoServiceCommonOptions &opts,
-                      const RepoProperties &repoProps, bool noCheck);
+                      const RepoProperties &repoProps, bool noCheck, bool refresh = false );
 
 /**
  * Add repository specified in given repo file on \a repo_file_url. All repos
@@ -141,7 +147,20 @@ void add_repo_by_url(Zypper & zypper,
  * \param autorefresh Whether the repo should have autorefresh turned on
  */
 void add_repo_from_file(Zypper & zypper,
-                         const std::string & repo_file_url , const RepoServiceCommonOptions &opts, const RepoProperties &repoProps, bool noCheck);
+                         const std::string & repo_file_url , const RepoServiceCommonOptions &opts, const RepoProperties &repoProps, bool noCheck, bool refresh = false );
+
+/**
+ * Add the repositories listed in \a list_file, one <tt>URI ALIAS</tt> per
+ * line ('#' starts a comment, "-" reads stdin). All entries are validated
+ * before any repo is added. The options apply to all repos. If \a refresh
+ * is set, the enabled new repos are refreshed afterwards in one pass.
+ */
+void add_repos_from_list( Zypper & zypper,
+                          const Pathname & list_file,
+                          const RepoServiceCommonOptions &opts,
+                          const RepoProperties &repoProps,
+                          bool noCheck,
+                          bool refresh );
 
 /**
  * Add repository specified by \repo to system repositories.
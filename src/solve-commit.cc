@@ -17,7 +17,6 @@
 #include <zypp/base/IOStream.h>
 
 #include <zypp/media/MediaException.h>
-#include <zypp/misc/CheckAccessDeleted.h>
 
 #include "misc.h"		// confirm_licenses
 #include "repos.h"		// get_repo - used in dist_upgrade
@@ -27,6 +26,10 @@
 #include "utils/messages.h"
 #include "global-settings.h"
 #include "CommitSummary.h"
+#include "CacheEviction.h"
+#include "PackageStore.h"
+#include "PeerCache.h"
+#include "ScanAccessDeleted.h"
 
 #include "solve-commit.h"
 #include "commands/needs-rebooting.h"
@@ -613,14 +616,15 @@ DownloadMode SolveAndCommitPolicy::downloadMode() const
  * This is called after each commit to notify user about running processes that
  * use libraries or other files that have been removed since their execution.
  */
-static void notify_processes_using_deleted_files( Zypper & zypper )
+static void notify_processes_using_deleted_files( Zypper & zypper, ScanAccessDeleted::FileFilter touchedFiles_r )
 {
   if ( ! zypper.config().psCheckAccessDeleted ) {
     zypper.out().info( str::form(_("Check for running processes using deleted libraries is disabled in zypper.conf. Run '%s' to check manually."),
                                  "zypper ps -s" ) );
   } else {
     zypper.out().info(_("Checking for running processes using deleted libraries..."), Out::HIGH );
-    CheckAccessDeleted checker( false ); // wait for explicit call to check()
+    ScanAccessDeleted checker;
+    checker.setFileFilter( std::move(touchedFiles_r) );	// just the files the commit replaced or removed
     try
     {
       checker.check();
@@ -939,6 +943,9 @@ void solve_and_commit ( Zypper &zypper, SolveAndCommitPolicy policy )
         }
 
         std::optional<ZYppCommitResult> result;
+        // The files touched by the commit restrict the post commit check for processes using
+        // deleted files. Must be collected before the commit, as the pool is reloaded afterwards.
+        ScanAccessDeleted::FileFilter touchedFiles;
         try
         {
           RuntimeData & gData = Zypper::instance().runtimeData();
@@ -964,6 +971,27 @@ void solve_and_commit ( Zypper &zypper, SolveAndCommitPolicy policy )
           // bsc#1183268: Patch reboot-needed flag overrules included packages.
           PatchRebootRulesWatchdog guard { summary.hasViewOption( Summary::PATCH_REBOOT_RULES ) && not summary.needMachineReboot() };
 
+          // Provide packages already downloaded for other repos from the shared store.
+          if ( PackageStore::enabled( zypper ) && ! policy.zyppCommitPolicy().dryRun() )
+          {
+            unsigned adopted = PackageStore( zypper ).adoptTransaction( God->resolver()->getTransaction() );
+            if ( adopted )
+              zypper.out().info( str::Format(PL_("%1% package provided by the shared package store.",
+                                                 "%1% packages provided by the shared package store.", adopted )) % adopted, Out::HIGH );
+          }
+
+          // Ask the peer cache before downloading from the repos.
+          if ( PeerCache::enabled( zypper ) && ! policy.zyppCommitPolicy().dryRun() )
+          {
+            unsigned fetched = PeerCache( zypper ).fetchTransaction( God->resolver()->getTransaction() );
+            if ( fetched )
+              zypper.out().info( str::Format(PL_("%1% package provided by the peer cache.",
+                                                 "%1% packages provided by the peer cache.", fetched )) % fetched, Out::HIGH );
+          }
+
+          if ( zypper.config().psCheckAccessDeleted && ! ( zypper.config().changedRoot || dryRunEtc ) )
+            touchedFiles = ScanAccessDeleted::filesTouchedBy( God->resolver()->getTransaction() );
+
           MIL << "Using commit policy: " << policy.zyppCommitPolicy() << endl;
           result = God->commit( policy.zyppCommitPolicy() );
 
@@ -981,6 +1009,15 @@ void solve_and_commit ( Zypper &zypper, SolveAndCommitPolicy policy )
           }
 
           show_update_messages( zypper, result->updateMessages() );
+
+          // Keep the caches within the budget configured in zypper.conf.
+          const CacheEviction::Policy & evictionPolicy { CacheEviction::configured( zypper ) };
+          if ( ! evictionPolicy.empty() && ! dryRunEtc )
+          {
+            const CacheEviction::Result & evicted { CacheEviction( zypper ).evict( evictionPolicy ) };
+            if ( evicted.freed )
+              zypper.out().info( str::Format(_("Freed %1% of cached packages and metadata.")) % evicted.freed );
+          }
         }
         catch ( const media::MediaException & e )
         {
@@ -1102,7 +1139,7 @@ void solve_and_commit ( Zypper &zypper, SolveAndCommitPolicy policy )
         if ( !( zypper.config().changedRoot || dryRunEtc )
           && ( summary.packagesToRemove() || summary.packagesToUpgrade() || summary.packagesToDowngrade() ) )
         {
-          notify_processes_using_deleted_files( zypper );
+          notify_processes_using_deleted_files( zypper, std::move(touchedFiles) );
         }
       }
     }
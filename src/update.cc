@@ -1,27 +1,36 @@
 #include <iostream> // for xml and table output
 #include <sstream>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+#include <unistd.h>
 
 #include <zypp/base/LogTools.h>
 #include <zypp/ZYppFactory.h>
 #include <zypp/base/Algorithm.h>
 #include <zypp/base/Iterable.h>
-#include <zypp/PoolQuery.h>
+#include <zypp/PathInfo.h>
+#include <zypp/RepoStatus.h>
 
 #include <zypp/Patch.h>
 
 #include "SolverRequester.h"
 #include "Table.h"
 #include "update.h"
+#include "PatchTable.h"
+#include "UpdateSnapshot.h"
 #include "main.h"
 #include "global-settings.h"
 #include "utils/misc.h"
 
 using namespace zypp;
 typedef std::set<PoolItem> Candidates;
+typedef std::function<void(const PoolItem &)> CandidateConsumer;
 
 extern ZYpp::Ptr God;
 
 static void find_updates( const ResKindSet & kinds, Candidates & candidates, bool all_r );
+static void find_updates( const ResKindSet & kinds, const CandidateConsumer & consumer_r, bool all_r );
 
 ///////////////////////////////////////////////////////////////////
 /// will go into next libzypp
@@ -38,21 +47,22 @@ namespace zypp_pending
 ///////////////////////////////////////////////////////////////////
 namespace
 {
-  inline bool patchIsApplicable( const PoolItem & pi )	///< Default content for all patch lists: applicable (needed, optional, unwanted)
-  { return pi.isBroken(); }
+  inline bool patchIsNeededRestartSuggested( const PatchTable::Entry & entry_r )	///< Needed update stack pack; installed first!
+  { return entry_r.neededRestartSuggested( Zypper::instance().config().exclude_optional_patches ); }
 
-  inline bool patchIsNeededRestartSuggested( const PoolItem & pi )	///< Needed update stack pack; installed first!
+  /** RNC: Print the update-commons elements description and license (unless --brief). */
+  inline void xmlPrintUpdateDetailsOn( std::ostream & str, const std::string & description_r, const std::string & license_r )
   {
-    return pi.isBroken()
-    && ! pi.isUnwanted()
-    && ! ( Zypper::instance().config().exclude_optional_patches && pi->asKind<Patch>()->categoryEnum() == Patch::CAT_OPTIONAL )
-    && pi->asKind<Patch>()->restartSuggested();
+    if ( XmlUpdateListSettings::instance()._brief )
+      return;
+    dumpAsXmlOn( str, description_r, "description" );
+    dumpAsXmlOn( str, license_r, "license" );
   }
 
   /** RNC: Print other-update element */
   inline std::ostream & xmlPrintOtherUpdateOn( std::ostream & str, const PoolItem & pi_r )
   {
-    xmlout::Node parent { cout, "update", xmlout::Node::optionalContent, {
+    xmlout::Node parent { str, "update", xmlout::Node::optionalContent, {
       { "kind", pi_r.kind() },
       { "name", pi_r.name () },
       { "edition", pi_r.edition() },
@@ -71,8 +81,7 @@ namespace
     }
 
     dumpAsXmlOn( *parent, pi_r.summary(), "summary" );
-    dumpAsXmlOn( *parent, pi_r.description(), "description" );
-    dumpAsXmlOn( *parent, pi_r.licenseToConfirm(), "license" );
+    xmlPrintUpdateDetailsOn( *parent, pi_r.description(), pi_r.licenseToConfirm() );
 
     if ( !pi_r.repoInfo().alias().empty() )
     {
@@ -134,8 +143,7 @@ namespace
         DBG << "PatchHistoryData " << res.second << " but " << pi_r << endl;
     }
     dumpAsXmlOn( *parent, patch->summary(), "summary" );
-    dumpAsXmlOn( *parent, patch->description(), "description" );
-    dumpAsXmlOn( *parent, patch->licenseToConfirm(), "license" );
+    xmlPrintUpdateDetailsOn( *parent, patch->description(), patch->licenseToConfirm() );
 
     if ( !patch->repoInfo().alias().empty() )
     {
@@ -160,6 +168,128 @@ namespace
     return str;
   }
 
+  ///////////////////////////////////////////////////////////////////
+  /// \class PatchIssueIndex
+  /// \brief The issue references of all patches passing a filter, collected in a single pass.
+  ///
+  /// Replaces a PoolQuery per requested issue. Matching follows the former
+  /// queries: case insensitive, exact or substring match on the issue id; an
+  /// issue with specific type but no id matches all references of this type.
+  ///////////////////////////////////////////////////////////////////
+  class PatchIssueIndex
+  {
+  public:
+    struct Ref
+    {
+      PoolItem pi;
+      std::string type;
+      std::string id;
+      std::string ltype;	///< lowercased type
+      std::string lid;	///< lowercased id
+    };
+
+    template <class TFilter>
+    explicit PatchIssueIndex( TFilter && filter_r )
+    {
+      for ( const PatchTable::Entry & entry : PatchTable::instance() )
+      {
+        if ( ! filter_r( entry ) )
+          continue;
+        const PoolItem & pi { entry.item };
+        _patches.push_back( pi );
+
+        const Patch::constPtr & patch { entry.patch };
+        for_( it, patch->referencesBegin(), patch->referencesEnd() )
+        {
+          unsigned idx = _refs.size();
+          _refs.push_back( Ref{ pi, it.type(), it.id(), str::toLower( it.type() ), str::toLower( it.id() ) } );
+          _byId[_refs.back().lid].push_back( idx );
+          _byType[_refs.back().ltype].push_back( idx );
+        }
+      }
+      DBG << "Indexed " << _refs.size() << " references in " << _patches.size() << " patches" << endl;
+    }
+
+    /** The indexed patches (pool order). */
+    const std::vector<PoolItem> & patches() const
+    { return _patches; }
+
+    /** Call \c fnc_r(ref) for each reference matching \a issue_r exactly.
+     * Each matching reference is reported once.
+     */
+    template <class TFnc>
+    void forEachMatch( const Issue & issue_r, TFnc && fnc_r ) const
+    {
+      const std::string & ltype { str::toLower( issue_r.type() ) };
+      const std::vector<unsigned> * hits = nullptr;
+      if ( issue_r.specificType() && issue_r.anyId() )
+      {
+        if ( auto it { _byType.find( ltype ) }; it != _byType.end() )
+          hits = &it->second;
+      }
+      else
+      {
+        if ( auto it { _byId.find( str::toLower( issue_r.id() ) ) }; it != _byId.end() )
+          hits = &it->second;
+      }
+      if ( ! hits )
+        return;
+
+      for ( unsigned idx : *hits )
+      {
+        const Ref & ref { _refs[idx] };
+        if ( issue_r.specificType() && ref.ltype != ltype )
+          continue;	// assert correct type of specific IDs
+        fnc_r( ref );
+      }
+    }
+
+    /** Call \c fnc_r(ref) for each reference matching any of \a issues_r, in a single pass over the references.
+     * The issue id may match a substring of the reference id or (for issues of any
+     * type) the reference type (bnc#941309: let '--issue=bugzilla' also match the type).
+     * Each matching reference is reported once.
+     */
+    template <class TIssues, class TFnc>
+    void forEachSubstringMatch( const TIssues & issues_r, TFnc && fnc_r ) const
+    {
+      struct Pattern
+      {
+        std::string ltype;	///< lowercased type, if specific
+        std::string lid;	///< lowercased id, if specific
+        bool matchType;		///< id may also match the type
+      };
+      std::vector<Pattern> patterns;
+      for ( const Issue & issue : issues_r )
+      {
+        patterns.push_back( Pattern{ issue.specificType() ? str::toLower( issue.type() ) : std::string(),
+                                     issue.specificId() ? str::toLower( issue.id() ) : std::string(),
+                                     issue.anyType() && issue.specificId() } );
+      }
+
+      for ( const Ref & ref : _refs )
+      {
+        for ( const Pattern & pattern : patterns )
+        {
+          if ( ! pattern.ltype.empty() && ref.ltype != pattern.ltype )
+            continue;	// assert correct type of specific IDs
+          if ( pattern.lid.empty()
+            || ref.lid.find( pattern.lid ) != std::string::npos
+            || ( pattern.matchType && ref.ltype.find( pattern.lid ) != std::string::npos ) )
+          {
+            fnc_r( ref );
+            break;
+          }
+        }
+      }
+    }
+
+  private:
+    std::vector<PoolItem> _patches;
+    std::vector<Ref> _refs;
+    std::unordered_map<std::string,std::vector<unsigned>> _byId;	///< lowercased id to _refs index
+    std::unordered_map<std::string,std::vector<unsigned>> _byType;	///< lowercased type to _refs index
+  };
+
 } //namespace
 ///////////////////////////////////////////////////////////////////
 
@@ -210,19 +340,39 @@ namespace
     {}
 
     /** Optionally track total amount of applicable patches */
-    bool visit( const PoolItem & pi_r )
-    { bool ret = pi_r.isBroken(); if ( ret ) ++_visited; return ret; }
+    bool visit( const PatchTable::Entry & entry_r )
+    { bool ret = entry_r.applicable(); if ( ret ) ++_visited; return ret; }
 
     /** Optionally track total amount of applicable patches */
     void visit()
     { ++_visited; }
 
     /** Contributing to the stats */
-    void collect( const PoolItem & pi_r )
+    void collect( const PatchTable::Entry & entry_r )
     {
-      Patch::constPtr patch( pi_r->asKind<Patch>() );
-      if ( patch )
-      { collect( pi_r, patch ); }
+      ++_collected;
+      Level level = entry_r.unwanted() ? PatchCheckStats::kLOCKED
+                                       : ( entry_r.restartSuggested() ? PatchCheckStats::kUSTACK
+                                                                      : PatchCheckStats::kNEEDED );
+
+      Patch::Category cat = entry_r.category;
+      if ( level == kLOCKED )
+        ++_locked;
+      else if ( _excludeOptionalPatches && cat == Patch::CAT_OPTIONAL )
+        ++_optional;
+      else
+      {
+        ++_needed;
+        if ( cat == Patch::CAT_SECURITY )
+          ++_security;
+      }
+
+      // detailed stats:
+      Stats & detail( _stats[cat] );
+      ++detail[level];
+      const std::string & ctgry( entry_r.patch->category() );	// on the fly remember aliases, e.g. 'feature' == 'optional'
+      if ( asString( cat ) != ctgry )
+        detail._aka.insert( ctgry );
     }
 
     unsigned visited() const	{ return _visited; }
@@ -237,6 +387,11 @@ namespace
     void render( Out & out, bool withDetails_r ) const;
     void renderDetails( Out & out ) const;
 
+    /** Write the collected counters to \a str (restored by \ref read). */
+    void write( std::ostream & str ) const;
+    /** Restore the counters written by \ref write. */
+    bool read( std::istream & str );
+
   private:
     typedef ZeroInit<unsigned> Counter;
 
@@ -286,33 +441,6 @@ namespace
     typedef std::map<Patch::Category, Stats, CategorySort> StatsMap;
 
   private:
-    void collect( const PoolItem & pi_r, const Patch::constPtr & patch_r )
-    {
-      ++_collected;
-      Level level = pi_r.isUnwanted() ? PatchCheckStats::kLOCKED
-                                      : ( patch_r->restartSuggested() ? PatchCheckStats::kUSTACK
-                                                                      : PatchCheckStats::kNEEDED );
-
-      Patch::Category cat = patch_r->categoryEnum();
-      if ( level == kLOCKED )
-        ++_locked;
-      else if ( _excludeOptionalPatches && cat == Patch::CAT_OPTIONAL )
-        ++_optional;
-      else
-      {
-        ++_needed;
-        if ( cat == Patch::CAT_SECURITY )
-          ++_security;
-      }
-
-      // detailed stats:
-      Stats & detail( _stats[cat] );
-      ++detail[level];
-      const std::string & ctgry( patch_r->category() );	// on the fly remember aliases, e.g. 'feature' == 'optional'
-      if ( asString( cat ) != ctgry )
-        detail._aka.insert( ctgry );
-    }
-
     std::string renderCounter( const Counter & counter_r ) const
     { return counter_r ? asString(counter_r) : "-"; }
 
@@ -377,6 +505,146 @@ namespace
     }
   }
 
+  void PatchCheckStats::write( std::ostream & str ) const
+  {
+    str << "counters " << _visited << " " << _collected << " " << _needed << " "
+        << _security << " " << _optional << " " << _locked << endl;
+    for ( const auto & p : _stats )
+    {
+      const Stats & stats( p.second );
+      str << "category " << int(p.first) << " " << stats[kUSTACK] << " " << stats[kNEEDED] << " " << stats[kLOCKED];
+      for ( const std::string & aka : stats._aka )
+        str << " " << aka;
+      str << endl;
+    }
+  }
+
+  bool PatchCheckStats::read( std::istream & str )
+  {
+    for ( std::string line; std::getline( str, line ); )
+    {
+      std::vector<std::string> words;
+      str::split( line, std::back_inserter(words) );
+      if ( words.size() == 7 && words[0] == "counters" )
+      {
+        _visited   = str::strtonum<unsigned>( words[1] );
+        _collected = str::strtonum<unsigned>( words[2] );
+        _needed    = str::strtonum<unsigned>( words[3] );
+        _security  = str::strtonum<unsigned>( words[4] );
+        _optional  = str::strtonum<unsigned>( words[5] );
+        _locked    = str::strtonum<unsigned>( words[6] );
+      }
+      else if ( words.size() >= 5 && words[0] == "category" )
+      {
+        Stats & stats( _stats[Patch::Category(str::strtonum<int>( words[1] ))] );
+        stats[kUSTACK] = str::strtonum<unsigned>( words[2] );
+        stats[kNEEDED] = str::strtonum<unsigned>( words[3] );
+        stats[kLOCKED] = str::strtonum<unsigned>( words[4] );
+        stats._aka.insert( words.begin()+5, words.end() );
+      }
+      else
+        return false;
+    }
+    return true;
+  }
+
+  /** Modification stamp of the rpm database (like libzypp's RpmDb timestamp).
+   * The ndb and sqlite databases are written in place, so the directory
+   * mtime does not tell. For sqlite the write-ahead log is included.
+   */
+  std::string rpmdbStamp( const Pathname & root_r )
+  {
+    std::ostringstream ret;
+    for ( const char * dir : { "/usr/lib/sysimage/rpm", "/var/lib/rpm" } )
+    {
+      for ( const char * file : { "rpmdb.sqlite", "Packages.db", "Packages" } )
+      {
+        PathInfo pi( Pathname::assertprefix( root_r, dir ) / file );
+        if ( ! pi.isFile() )
+          continue;
+        ret << file << " " << pi.mtime() << " " << pi.size();
+        PathInfo wal( pi.path().extend( "-wal" ) );
+        if ( wal.isFile() )
+          ret << " wal " << wal.mtime() << " " << wal.size();
+        return ret.str();
+      }
+    }
+    return "none";	// no cache hits then
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  /// \class PatchCheckCache
+  /// \brief The patch-check stats of the last run, remembered together with the input they were computed from.
+  ///
+  /// The key is built from the raw metadata status of the repos to load,
+  /// the rpm database, the locks file and the patch-check options. If the
+  /// key is unchanged, the stats are rendered without loading the pool.
+  ///////////////////////////////////////////////////////////////////
+  struct PatchCheckCache
+  {
+    PatchCheckCache( Zypper & zypper_r, bool updatestackOnly_r )
+    : _file( Pathname::assertprefix( zypper_r.config().root_dir, zypper_r.config().rm_options.repoCachePath ) / "zypper" / "patch-check.cache" )
+    {
+      const Config & config { zypper_r.config() };
+      std::ostringstream key;
+      key << "options " << config.exclude_optional_patches << " " << updatestackOnly_r << endl;
+      key << "rpmdb " << rpmdbStamp( config.root_dir ) << endl;
+      key << "locks " << RepoStatus( Pathname::assertprefix( config.root_dir, ZConfig::instance().locksFile() ) ) << endl;
+      for ( const RepoInfo & repo : zypper_r.runtimeData().repos )
+      {
+        if ( ! repo.enabled() )
+          continue;
+        key << "repo " << repo.alias() << " " << repo.priority() << " " << zypper_r.repoManager().metadataStatus( repo ) << endl;
+      }
+      std::istringstream keystr( key.str() );
+      _key = CheckSum::sha256( keystr ).checksum();
+    }
+
+    /** Restore \a stats_r if the cache matches the current input. */
+    bool load( PatchCheckStats & stats_r ) const
+    {
+      std::ifstream in( _file.c_str() );
+      std::string line;
+      if ( ! std::getline( in, line ) || line != _key )
+        return false;
+      return stats_r.read( in );
+    }
+
+    void save( const PatchCheckStats & stats_r ) const
+    {
+      filesystem::assert_dir( _file.dirname() );
+      const Pathname & tmpfile { _file.extend( ".new"+str::numstring( ::getpid() ) ) };
+      {
+        std::ofstream out( tmpfile.c_str() );
+        out << _key << endl;
+        stats_r.write( out );
+        if ( ! out )
+        {
+          DBG << "Can't write patch-check cache " << tmpfile << endl;
+          filesystem::unlink( tmpfile );
+          return;
+        }
+      }
+      if ( filesystem::rename( tmpfile, _file ) != 0 )
+        filesystem::unlink( tmpfile );
+    }
+
+  private:
+    Pathname _file;
+    std::string _key;
+  };
+
+  /** Render the patch-check stats and compute the exit code. */
+  void patch_check_render( Zypper & zypper, const PatchCheckStats & stats )
+  {
+    Out & out( zypper.out() );
+    out.gap();
+    stats.render( out, /*withDetails*/true );
+
+    if ( stats.needed() )
+    { zypper.setExitCode( stats.security() ? ZYPPER_EXIT_INF_SEC_UPDATE_NEEDED : ZYPPER_EXIT_INF_UPDATE_NEEDED ); }
+  }
+
   void PatchCheckStats::renderDetails( Out & out ) const
   {
     if ( out.typeNORMAL() )
@@ -439,64 +707,66 @@ namespace
 } // namespace
 ///////////////////////////////////////////////////////////////////
 
+bool patch_check_cached( bool updatestackOnly )
+{
+  Zypper & zypper( Zypper::instance() );
+  if ( ! zypper.config().patchCheckCache )
+    return false;
+  if ( ! zypper.runtimeData().temporary_repos.empty() )
+    return false;	// not part of the cache key
+  if ( zypper.runtimeData().snapshot_read )
+    return false;	// the rpm database may be in the middle of a transaction
+
+  PatchCheckStats stats( zypper.config().exclude_optional_patches );
+  if ( ! PatchCheckCache( zypper, updatestackOnly ).load( stats ) )
+    return false;
+
+  MIL << "patch check: input unchanged, using cached stats" << endl;
+  patch_check_render( zypper, stats );
+  return true;
+}
+
 void patch_check( bool updatestackOnly )
 {
   Zypper & zypper( Zypper::instance() );
-  Out & out( zypper.out() );
   DBG << "patch check" << endl;
 
   PatchCheckStats stats( zypper.config().exclude_optional_patches );
-  for_( it, God->pool().byKindBegin(ResKind::patch), God->pool().byKindEnd(ResKind::patch) )
+  for ( const PatchTable::Entry & entry : PatchTable::instance() )
   {
-    const PoolItem & pi( *it );
-    if ( ! stats.visit( pi ) )	// count total applicable patches
+    if ( ! stats.visit( entry ) )	// count total applicable patches
       continue;
 
     // filter out by cli options
-    if ( updatestackOnly && !pi->asKind<Patch>()->restartSuggested() )
+    if ( updatestackOnly && ! entry.restartSuggested() )
       continue;
 
     // remaining: collect stats
-    stats.collect( pi );
+    stats.collect( entry );
   }
 
-  // render output
-  out.gap();
-  stats.render( out, /*withDetails*/true );
-
-  // compute exit code
-  if ( stats.needed() )
-  { zypper.setExitCode( stats.security() ? ZYPPER_EXIT_INF_SEC_UPDATE_NEEDED : ZYPPER_EXIT_INF_UPDATE_NEEDED ); }
+  if ( zypper.config().patchCheckCache && zypper.runtimeData().temporary_repos.empty() && ! zypper.runtimeData().snapshot_read )
+    PatchCheckCache( zypper, updatestackOnly ).save( stats );
+  patch_check_render( zypper, stats );
 }
 
 // returns true if NEEDED! restartSuggested() patches are available
 static bool xml_list_patches (Zypper & zypper, bool all_r, const PatchHistoryData & patchHistoryData_r )
 {
-  const ResPool& pool = God->pool();
+  const PatchTable & patches { PatchTable::instance() };
 
   // check whether there are packages affecting the update stack
-  bool pkg_mgr_available = false;
-  for_( it, pool.byKindBegin(ResKind::patch), pool.byKindEnd(ResKind::patch) )
-  {
-    if ( patchIsNeededRestartSuggested( *it ) )
-    {
-      pkg_mgr_available = true;
-      break;
-    }
-  }
+  bool pkg_mgr_available = patches.anyNeededRestartSuggested( zypper.config().exclude_optional_patches );
 
   unsigned patchcount = 0;
-  for_( it, pool.byKindBegin(ResKind::patch), pool.byKindEnd(ResKind::patch) )
+  for ( const PatchTable::Entry & entry : patches )
   {
-    if ( all_r || patchIsApplicable( *it ) )
+    if ( all_r || entry.applicable() )
     {
-      const PoolItem & pi( *it );
-      Patch::constPtr patch = pi->asKind<Patch>();
-
       // if updates stack patches are available, show only those
-      if ( all_r || !pkg_mgr_available || patchIsNeededRestartSuggested( pi ) )
+      if ( all_r || !pkg_mgr_available || patchIsNeededRestartSuggested( entry ) )
       {
-        xmlPrintPatchUpdateOn( cout, pi, patchHistoryData_r );
+        xmlPrintPatchUpdateOn( cout, entry.item, patchHistoryData_r );
       }
     }
     ++patchcount;
@@ -514,15 +784,10 @@ static bool xml_list_patches (Zypper & zypper, bool all_r, const PatchHistoryDat
     if ( ! all_r )
     {
     cout << "<blocked-update-list>" << endl;
-    for_( it, pool.byKindBegin(ResKind::patch), pool.byKindEnd(ResKind::patch) )
+    for ( const PatchTable::Entry & entry : patches )
     {
-      if ( patchIsApplicable( *it ) )
-      {
-        const PoolItem & pi( *it );
-        Patch::constPtr patch = pi->asKind<Patch>();
-        if ( ! patchIsNeededRestartSuggested( pi ) )
-          xmlPrintPatchUpdateOn( cout, pi, patchHistoryData_r );
-      }
+      if ( entry.applicable() && ! patchIsNeededRestartSuggested( entry ) )
+        xmlPrintPatchUpdateOn( cout, entry.item, patchHistoryData_r );
     }
     cout << "</blocked-update-list>" << endl;
     }
@@ -535,13 +800,10 @@ static bool xml_list_patches (Zypper & zypper, bool all_r, const PatchHistoryDat
 
 static void xml_list_updates(const ResKindSet & kinds, bool all_r )
 {
-  Candidates candidates;
-  find_updates( kinds, candidates, all_r );
-
-  for( const PoolItem & pi : candidates )
-  {
+  // stream each update as soon as it is found
+  find_updates( kinds, []( const PoolItem & pi ) {
     xmlPrintOtherUpdateOn( cout, pi );
-  }
+  }, all_r );
 }
 
 // ----------------------------------------------------------------------------
@@ -558,26 +820,22 @@ static bool list_patch_updates( Zypper & zypper, bool all_r, const PatchSelector
   PatchCheckStats stats( zypper.config().exclude_optional_patches );
   CliMatchPatch cliMatchPatch( zypper, sel._requestedPatchDates, sel._requestedPatchCategories, sel._requestedPatchSeverity );
 
-  const ResPool& pool = God->pool();
-  for_( it, pool.byKindBegin(ResKind::patch), pool.byKindEnd(ResKind::patch) )
+  for ( const PatchTable::Entry & entry : PatchTable::instance() )
   {
-    const PoolItem & pi( *it );
-    Patch::constPtr patch = asKind<Patch>(pi);
-
-    bool tostat = stats.visit( pi );	// count total applicable patches
+    bool tostat = stats.visit( entry );	// count total applicable patches
 
-    if ( ! cliMatchPatch( patch ) )
+    if ( ! cliMatchPatch( entry ) )
       continue;
 
     if ( tostat )	// exclude cliMatchPatch filtered but include undisplayed ones
-      stats.collect( pi );
+      stats.collect( entry );
 
-    if ( all_r || patchIsApplicable( pi ) )
+    if ( all_r || entry.applicable() )
     {
-      if ( ! all_r && patchIsNeededRestartSuggested( pi ) )
-        intoPMTbl( pi );
+      if ( ! all_r && patchIsNeededRestartSuggested( entry ) )
+        intoPMTbl( entry.item );
       else
-        intoTbl( pi );
+        intoTbl( entry.item );
     }
   }
 
@@ -627,7 +885,7 @@ static bool list_patch_updates( Zypper & zypper, bool all_r, const PatchSelector
  * Find all available updates of given kind.
  */
 static void
-find_updates( const ResKind & kind, Candidates & candidates, bool all_r )
+find_updates( const ResKind & kind, const CandidateConsumer & consumer_r, bool all_r )
 {
   const ResPool& pool = God->pool();
   DBG << "Looking for update candidates of kind " << kind << endl;
@@ -651,7 +909,7 @@ find_updates( const ResKind & kind, Candidates & candidates, bool all_r )
         ui::Selectable::constPtr s =
             ui::Selectable::get((*it)->kind(), (*it)->name());
         if (s->hasInstalledObj())
-          candidates.insert(*it);
+          consumer_r(*it);
       }
     }
     return;
@@ -673,7 +931,7 @@ find_updates( const ResKind & kind, Candidates & candidates, bool all_r )
 
     DBG << "selectable: " << **it << endl;
     DBG << "candidate: " << candidate << endl;
-    candidates.insert (candidate);
+    consumer_r (candidate);
   }
 }
 
@@ -683,15 +941,33 @@ find_updates( const ResKind & kind, Candidates & candidates, bool all_r )
  * Find all available updates of given kinds.
  */
 void
-find_updates(const ResKindSet & kinds, Candidates & candidates , bool all_r)
+find_updates(const ResKindSet & kinds, const CandidateConsumer & consumer_r, bool all_r)
 {
   for (ResKindSet::const_iterator kit = kinds.begin(); kit != kinds.end(); ++kit)
-    find_updates( *kit, candidates, all_r );
+    find_updates( *kit, consumer_r, all_r );
 
   if (kinds.empty())
     WAR << "called with empty kinds set" << endl;
 }
 
+/**
+ * Collect all available updates of given kinds.
+ */
+void
+find_updates(const ResKindSet & kinds, Candidates & candidates , bool all_r)
+{
+  find_updates( kinds, [&candidates]( const PoolItem & pi ) { candidates.insert( pi ); }, all_r );
+}
+
+/**
+ * Collect all available updates of given kind.
+ */
+static void
+find_updates( const ResKind & kind, Candidates & candidates, bool all_r )
+{
+  find_updates( kind, [&candidates]( const PoolItem & pi ) { candidates.insert( pi ); }, all_r );
+}
+
 // ----------------------------------------------------------------------------
 
 std::string i18n_kind_updates(const ResKind & kind)
@@ -845,6 +1121,110 @@ void list_updates(Zypper & zypper, const ResKindSet & kinds, bool best_effort, b
   }
 }
 
+// ----------------------------------------------------------------------------
+
+void list_updates_since_snapshot( Zypper & zypper, const ResKindSet & kinds, bool all_r, const PatchSelector & patchSel_r, const Pathname & snapshot_r )
+{
+  UpdateSnapshot previous;
+  if ( ! previous.load( snapshot_r ) )
+  {
+    zypper.out().error( str::Format(_("File '%1%' is not a valid snapshot file.")) % snapshot_r );
+    zypper.setExitCode( ZYPPER_EXIT_ERR_INVALID_ARGS );
+    return;
+  }
+
+  // collect the current candidates like list_updates does
+  UpdateSnapshot current;
+  ResKindSet localkinds = kinds;
+  if ( localkinds.erase( ResKind::patch ) )
+  {
+    CliMatchPatch cliMatchPatch( zypper, patchSel_r._requestedPatchDates, patchSel_r._requestedPatchCategories, patchSel_r._requestedPatchSeverity );
+    for ( const PatchTable::Entry & entry : PatchTable::instance() )
+    {
+      if ( ( all_r || entry.applicable() ) && cliMatchPatch( entry ) )
+        current.add( entry.item );
+    }
+  }
+  if ( ! localkinds.empty() )
+  {
+    Candidates candidates;
+    find_updates( localkinds, candidates, all_r );
+    for ( const PoolItem & pi : candidates )
+      current.add( pi );
+  }
+
+  const UpdateSnapshot::Delta & delta { UpdateSnapshot::diff( previous, current ) };
+  MIL << "Snapshot delta: " << delta.added.size() << " added, " << delta.removed.size() << " removed, " << delta.changed.size() << " changed" << endl;
+
+  if ( zypper.out().type() == Out::TYPE_XML )
+  {
+    xmlout::Node parent { cout, "update-delta", xmlout::Node::optionalContent, {
+      { "previous", previous.size() },
+      { "current", current.size() },
+    } };
+    auto xmlEntry = [&parent]( const char * change_r, const UpdateSnapshot::Entry & entry_r, const UpdateSnapshot::Entry * old_r = nullptr ) {
+      xmlout::Node node { *parent, "update", xmlout::Node::optionalContent, {
+        { "change", change_r },
+        { "kind", entry_r.kind },
+        { "name", entry_r.name },
+        { "edition", entry_r.edition },
+        { "arch", entry_r.arch },
+        { "repo", entry_r.repo },
+      } };
+      if ( old_r )
+      {
+        node.addAttr( { "edition-old", old_r->edition } );
+        node.addAttr( { "repo-old", old_r->repo } );
+      }
+    };
+    for ( const auto & entry : delta.added )
+      xmlEntry( "added", entry );
+    for ( const auto & entry : delta.removed )
+      xmlEntry( "removed", entry );
+    for ( const auto & entry : delta.changed )
+      xmlEntry( "changed", entry.second, &entry.first );
+  }
+  else if ( delta.empty() )
+  {
+    zypper.out().info(_("No changes since the last snapshot.") );
+  }
+  else
+  {
+    Table tbl;
+    {
+      TableHeader th;
+      // translator: Table column header: whether an update candidate was added, removed or changed
+      th << N_("Change")
+      << N_("Type")
+      << table::Column( N_("Name"), table::CStyle::SortCi )
+      << table::Column( N_("Previous Version"), table::CStyle::Edition )
+      << table::Column( N_("Available Version"), table::CStyle::Edition )
+      << N_("Arch")
+      << N_("Repository");
+      tbl << std::move(th);
+    }
+    for ( const auto & entry : delta.added )
+      tbl << ( TableRow() << POSITIVEString( _("added") ).str() << entry.kind << entry.name << "" << entry.edition << entry.arch << entry.repo );
+    for ( const auto & entry : delta.removed )
+      tbl << ( TableRow() << NEGATIVEString( _("removed") ).str() << entry.kind << entry.name << entry.edition << "" << entry.arch << entry.repo );
+    for ( const auto & entry : delta.changed )
+      tbl << ( TableRow() << CHANGEString( _("changed") ).str() << entry.second.kind << entry.second.name << entry.first.edition << entry.second.edition << entry.second.arch << entry.second.repo );
+    tbl.sort( 2 );
+
+    cout << tbl;
+    zypper.out().gap();
+    // translator: %1%, %2% and %3% are the numbers of added, removed and changed update candidates
+    zypper.out().info( str::Format(_("%1% added, %2% removed, %3% changed since the last snapshot.") )
+                       % delta.added.size() % delta.removed.size() % delta.changed.size() );
+  }
+
+  if ( ! current.save( snapshot_r ) )
+  {
+    zypper.out().error( str::Format(_("Failed to write snapshot file '%1%'.")) % snapshot_r );
+    zypper.setExitCode( ZYPPER_EXIT_ERR_ZYPP );
+  }
+}
+
 // ----------------------------------------------------------------------------
 void list_patches_by_issue( Zypper & zypper, bool all_r, const PatchSelector & sel_r )
 {
@@ -858,80 +1238,50 @@ void list_patches_by_issue( Zypper & zypper, bool all_r, const PatchSelector & s
                                sel_r._requestedPatchSeverity );
 
 
+  // All patches passing the CLI filter and their issue references are collected
+  // in a single pass, instead of querying the pool once per requested issue.
+  PatchIssueIndex index( [&]( const PatchTable::Entry & entry )->bool {
+    if ( only_needed && ! entry.applicable() )
+      return false;
+    if ( ! cliMatchPatch( entry ) )
+    {
+      DBG << entry.item.ident() << " skipped. (not matching CLI filter)" << endl;
+      return false;
+    }
+    return true;
+  } );
+
   // pass1 finding PoolItems and their matching issues (pi,itype,iid)
-  std::vector<const Issue*> pass2; // on the fly remember anyType issues for pass2
+  std::vector<std::string> pass2; // on the fly remember anyType issues for pass2 (lowercased id)
   std::map<PoolItem,std::map<std::string,std::set<std::string>>> iresult;
   for ( const Issue & issue : sel_r._requestedIssues )
   {
-    PoolQuery q;
-    q.setMatchSubstring();
-    q.setCaseSensitive( false );
-    q.addKind( ResKind::patch );
-    // PoolQuery ORs attributes but we need AND.
-    // Post processing the match must assert correct type of specific IDs!
-    if ( issue.specificType() && issue.anyId() )
-    { q.addAttribute(sat::SolvAttr::updateReferenceType, issue.type() ); }
-    else
-    {
-      q.addAttribute( sat::SolvAttr::updateReferenceId, issue.id() );
-      if ( issue.anyType() && issue.specificId() ) 				// remember for pass2
-      {
-        q.addAttribute( sat::SolvAttr::updateReferenceType, issue.id() );	// bnc#941309: let '--issue=bugzilla' also match the type
-        pass2.push_back( &issue );
-      }
-    }
-
-    for_( it, q.begin(), q.end() )
-    {
-      PoolItem pi { *it };
-
-      if ( only_needed && ! patchIsApplicable( pi ) )
-        continue;
-
-      if ( ! cliMatchPatch( pi ) )
-      {
-        DBG << pi.ident() << " skipped. (not matching CLI filter)" << endl;
-        continue;
-      }
-
-      for_( d, it.matchesBegin(), it.matchesEnd() )
-      {
-        std::string itype { d->subFind( sat::SolvAttr::updateReferenceType ).asString() };
-        if ( issue.specificType() && itype != issue.type() )
-          continue;	// assert correct type of specific IDs
-        // remember....
-        iresult[std::move(pi)][std::move(itype)].insert( d->subFind( sat::SolvAttr::updateReferenceId ).asString() );
-      }
-    }
+    if ( issue.anyType() && issue.specificId() ) 				// remember for pass2
+      pass2.push_back( str::toLower( issue.id() ) );
   }
+  index.forEachSubstringMatch( sel_r._requestedIssues, [&]( const PatchIssueIndex::Ref & ref ) {
+    iresult[ref.pi][ref.type].insert( ref.id );
+  } );
 
-  //pass2 (summary/description)
-  std::vector<PoolItem> dresult;	// query will assert unique entries
-  for ( const Issue * _issue : pass2 )
+  //pass2 (summary/description) in a single pass over all patches
+  std::vector<PoolItem> dresult;
+  if ( ! pass2.empty() )
   {
-    const Issue & issue { *_issue };
-    PoolQuery q;
-    q.setMatchSubstring();
-    q.setCaseSensitive( false );
-    q.addKind( ResKind::patch );
-    q.addAttribute(sat::SolvAttr::summary, issue.id() );
-    q.addAttribute(sat::SolvAttr::description, issue.id() );
-
-    for_( it, q.begin(), q.end() )
+    for ( const PoolItem & pi : index.patches() )
     {
-      PoolItem pi { *it };
-
-      if ( only_needed && ! patchIsApplicable( pi ) )
+      if ( iresult.count( pi ) )
         continue;
 
-      if ( ! cliMatchPatch( pi ) )
+      const std::string & summary { str::toLower( pi.summary() ) };
+      const std::string & description { str::toLower( pi.description() ) };
+      for ( const std::string & id : pass2 )
       {
-        DBG << pi.ident() << " skipped. (not matching CLI filter)" << endl;
-        continue;
+        if ( summary.find( id ) != std::string::npos || description.find( id ) != std::string::npos )
+        {
+          dresult.push_back( pi );
+          break;
+        }
       }
-
-      if ( ! iresult.count( pi ) )
-      { dresult.push_back( pi ); }
     }
   }
 
@@ -999,48 +1349,24 @@ void list_patches_by_issue( Zypper & zypper, bool all_r, const PatchSelector & s
 
 void mark_updates_by_issue( Zypper & zypper, const std::set<Issue> &issues, SolverRequester::Options srOpts )
 {
+  // CliMatchPatch not needed, it's fed into srOpts!
+  PatchIssueIndex index( []( const PatchTable::Entry & entry )->bool {
+    return entry.applicable(); // not needed
+  } );
+
   for ( const Issue & issue : issues )
   {
-    PoolQuery q;
-    q.setMatchExact();
-    q.setCaseSensitive( false );
-    q.addKind( ResKind::patch );
-    // PoolQuery ORs attributes but we need AND.
-    // Post processing the match must assert correct type of specific IDs!
-    if ( issue.specificType() && issue.anyId() )
-    { q.addAttribute(sat::SolvAttr::updateReferenceType, issue.type() ); }
-    else
-    { q.addAttribute( sat::SolvAttr::updateReferenceId, issue.id() ); }
-
     SolverRequester sr( srOpts );
     bool found = false;
 
-    for_( it, q.begin(), q.end() )
-    {
-      PoolItem pi( *it );
-      Patch::constPtr patch = asKind<Patch>(pi);
-
-      if ( !pi.isBroken() ) // not needed
-        continue;
-
-      // CliMatchPatch not needed, it's fed into srOpts!
-
-      DBG << "got: " << *it << endl;
-
-      for_( d, it.matchesBegin(), it.matchesEnd() )
-      {
-        const std::string & itype = d->subFind( sat::SolvAttr::updateReferenceType ).asString();
-
-        if ( issue.specificType() && itype != issue.type() )
-          continue;	// assert correct type of specific IDs
-
-        if ( sr.installPatch( pi ) )
-          found = true;
-        else
-          DBG << str::form("fix for %s issue number %s was not marked.",
-                           issue.type().c_str(), issue.id().c_str() );
-      }
-    }
+    index.forEachMatch( issue, [&]( const PatchIssueIndex::Ref & ref ) {
+      DBG << "got: " << ref.pi << endl;
+      if ( sr.installPatch( ref.pi ) )
+        found = true;
+      else
+        DBG << str::form("fix for %s issue number %s was not marked.",
+                         issue.type().c_str(), issue.id().c_str() );
+    } );
 
     sr.printFeedback( zypper.out() );
     if ( ! found )
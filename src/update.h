@@ -21,6 +21,14 @@ struct PatchSelector {
  */
 void patch_check(bool updatestackOnly);
 
+/**
+ * Render the patch-check stats remembered by the last \ref patch_check
+ * if its input (repos metadata, rpm database, locks, options) is unchanged.
+ * Needs initialized repos but no loaded pool.
+ * \return Whether cached stats were rendered.
+ */
+bool patch_check_cached(bool updatestackOnly);
+
 /**
  * Lists available updates of installed resolvables of specified \a kind.
  * if repo_alias != "", restrict updates to this repository.
@@ -36,6 +44,17 @@ void list_updates(Zypper & zypper,
                   bool all,
                   const PatchSelector &patchSel_r = PatchSelector() );
 
+/**
+ * Like \ref list_updates, but report just the candidates added, removed or
+ * changed since the snapshot in \a snapshot_r was saved. The current
+ * candidates are saved to \a snapshot_r afterwards (--since-snapshot).
+ */
+void list_updates_since_snapshot(Zypper & zypper,
+                                 const ResKindSet & kinds,
+                                 bool all,
+                                 const PatchSelector &patchSel_r,
+                                 const Pathname & snapshot_r );
+
 /**
  * List available fixes to all issues or issues specified in --bugzilla
  * or --cve options, or look for --issue[=str[ in numbers and descriptions
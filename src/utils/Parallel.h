@@ -0,0 +1,84 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+#ifndef ZYPPER_UTILS_PARALLEL_H
+#define ZYPPER_UTILS_PARALLEL_H
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/// \brief Minimal helpers to spread independent jobs across worker threads.
+///
+/// \note The jobs must not touch the libzypp pool or any other state which
+/// is not thread safe. Use them for plain file system or network work.
+namespace parallel
+{
+  /** Upper limit for the number of worker threads we start. */
+  constexpr unsigned maxWorkers = 8U;
+
+  /** Number of worker threads to use for \a jobs_r independent jobs (at most \a max_r or \ref maxWorkers). */
+  inline unsigned workers( size_t jobs_r, unsigned max_r = 0U )
+  {
+    unsigned ret = std::max( 1U, std::thread::hardware_concurrency() );
+    ret = std::min( ret, max_r ? max_r : maxWorkers );
+    return std::max<size_t>( 1U, std::min<size_t>( ret, jobs_r ) );
+  }
+
+  /** Split [0,size_r) into consecutive chunks and call \c fnc_r(worker,begin,end) for each chunk in a separate thread.
+   * If a single worker suffices, \a fnc_r is called in the current thread. The first
+   * exception thrown by a worker is rethrown after all workers have finished.
+   */
+  template <class TFnc>
+  void forChunks( size_t size_r, TFnc && fnc_r, unsigned max_r = 0U )
+  {
+    if ( ! size_r )
+      return;
+
+    unsigned nworkers = workers( size_r, max_r );
+    if ( nworkers == 1 )
+    {
+      fnc_r( 0U, size_t(0), size_r );
+      return;
+    }
+
+    std::vector<std::exception_ptr> errors( nworkers );
+    std::vector<std::thread> threads;
+    threads.reserve( nworkers );
+
+    size_t chunk = ( size_r + nworkers - 1 ) / nworkers;
+    for ( unsigned w = 0; w < nworkers; ++w )
+    {
+      size_t begin = std::min( size_r, w * chunk );
+      size_t end   = std::min( size_r, begin + chunk );
+      threads.emplace_back( [&fnc_r,&errors,w,begin,end]() {
+        try { fnc_r( w, begin, end ); }
+        catch ( ... ) { errors[w] = std::current_exception(); }
+      } );
+    }
+    for ( std::thread & t : threads )
+      t.join();
+
+    for ( const std::exception_ptr & e : errors )
+    {
+      if ( e )
+        std::rethrow_exception( e );
+    }
+  }
+
+  /** Call \c fnc_r(idx) for each idx in [0,size_r) using up to \a max_r worker threads. */
+  template <class TFnc>
+  void forEach( size_t size_r, TFnc && fnc_r, unsigned max_r = 0U )
+  {
+    forChunks( size_r, [&fnc_r]( unsigned, size_t begin_r, size_t end_r ) {
+      for ( size_t idx = begin_r; idx < end_r; ++idx )
+        fnc_r( idx );
+    }, max_r );
+  }
+
+} // namespace parallel
+#endif // ZYPPER_UTILS_PARALLEL_H
@@ -7,11 +7,13 @@
 
 #include <sstream>
 #include <iostream>
+#include <fstream>
 #include <unistd.h>          // for getcwd()
 
 #include <zypp/base/Logger.h>
 #include <zypp/base/String.h>
 #include <zypp/base/Regex.h>
+#include <zypp/PathInfo.h>
 #include <zypp/media/MediaManager.h>
 #include <zypp/ExternalProgram.h>
 #include <zypp/parser/ProductFileReader.h>
@@ -23,6 +25,8 @@
 #include <zypp/Product.h>
 #include <zypp/Pattern.h>
 #include <zypp/AutoDispose.h>
+#include <zypp/Locale.h>
+#include <zypp/ZConfig.h>
 
 #include "main.h"
 #include "Zypper.h"
@@ -231,18 +235,134 @@ std::string patchInteractiveFlags( const Patch & patch_r )
 
 ///////////////////////////////////////////////////////////////////
 /// class  PatchHistoryData
+/// The data are kept in an index file below the repo cache directory,
+/// remembering the last state of each patch and the position in the
+/// history file up to which it was parsed. Only history entries appended
+/// since the last run need to be parsed. If the history file was rotated
+/// or truncated, the index is rebuilt from scratch.
+///
+/// \code
+///   # zypper patch history index 1
+///   @ <history inode> <parsed bytes>
+///   <name>|<edition>|<arch>|<time_t>|<state>
+/// \endcode
 struct PatchHistoryData::D
 {
+  /** Cheap prefilter: whether the (padded) action field of \a line_r is a patch state change. */
+  static bool isPatchStateChange( const std::string & line_r )
+  {
+    std::string::size_type begin = line_r.find( '|' );
+    if ( begin == std::string::npos )
+      return false;
+    std::string::size_type end = line_r.find( '|', ++begin );
+    if ( end == std::string::npos )
+      return false;
+    return str::trim( line_r.substr( begin, end - begin ) ) == HistoryActionID::PATCH_STATE_CHANGE.asString();
+  }
+
+  void remember( const std::string & name_r, const Edition & edition_r, const Arch & arch_r, Date date_r, ResStatus::ValidateValue state_r )
+  {
+    value_type & value { _data[IdString("patch:"+name_r).id()][edition_r.id()][arch_r.id()] };
+    if ( date_r > value.first ) {
+      value.first = std::move(date_r);
+      value.second = state_r;
+    }
+  }
+
   void remember( HistoryLogPatchStateChange::Ptr ptr_r )
   {
     if ( ! ptr_r )
       return;
+    remember( ptr_r->name(), ptr_r->edition(), ptr_r->arch(), ptr_r->date(), ResStatus::stringToValidateValue( ptr_r->newstate() ) );
+  }
+
+  bool empty() const
+  { return _data.empty(); }
 
-    value_type & value { _data[IdString("patch:"+ptr_r->name()).id()][ptr_r->edition().id()][ptr_r->arch().id()] };
-    if ( Date date { ptr_r->date() }; date > value.first ) {
-      value.first = std::move(date);
-      value.second = ResStatus::stringToValidateValue( ptr_r->newstate() );
+  /** Load the index; return false if it does not match \a historyFile_r. */
+  bool loadIndex( const Pathname & index_r, const PathInfo & historyFile_r )
+  {
+    std::ifstream in( index_r.c_str() );
+    std::string line;
+    if ( ! std::getline( in, line ) || line != indexMagic )
+      return false;
+
+    std::vector<std::string> words;
+    if ( ! std::getline( in, line ) || str::split( line, std::back_inserter(words) ) != 3 || words[0] != "@" )
+      return false;
+    if ( str::strtonum<ino_t>( words[1] ) != historyFile_r.ino() )
+      return false;
+    _parsed = str::strtonum<off_t>( words[2] );
+    if ( _parsed > historyFile_r.size() )
+      return false;	// truncated (copytruncate)
+
+    while ( std::getline( in, line ) )
+    {
+      words.clear();
+      if ( str::split( line, std::back_inserter(words), "|" ) != 5 )
+        return false;
+      remember( words[0], Edition(words[1]), Arch(words[2]), Date( str::strtonum<Date::ValueType>( words[3] ) ), ResStatus::stringToValidateValue( words[4] ) );
     }
+    _loaded = _parsed;
+    return true;
+  }
+
+  /** Parse the history entries appended after the indexed position. */
+  void parseHistory( const Pathname & historyFile_r )
+  {
+    std::ifstream in( historyFile_r.c_str() );
+    if ( ! in.seekg( _parsed ) )
+      return;
+
+    for ( std::string line; std::getline( in, line ); )
+    {
+      if ( in.eof() )
+        break;	// incomplete last line; parse it next time
+      _parsed += line.size() + 1;
+
+      if ( ! isPatchStateChange( line ) )
+        continue;
+      HistoryLogData::FieldList fields;
+      str::splitEscaped( line, std::back_inserter(fields), "|", true );
+      try
+      { remember( dynamic_pointer_cast<HistoryLogPatchStateChange>( HistoryLogData::create( fields ) ) ); }
+      catch ( const Exception & )
+      { DBG << "Ignore invalid history entry: " << line << endl; }
+    }
+  }
+
+  /** Save the index (if there is anything new to save). */
+  void saveIndex( const Pathname & index_r, const PathInfo & historyFile_r ) const
+  {
+    if ( _parsed == _loaded )
+      return;
+
+    filesystem::assert_dir( index_r.dirname() );
+    const Pathname & tmpfile { index_r.extend( ".new"+str::numstring( ::getpid() ) ) };
+    {
+      std::ofstream out( tmpfile.c_str() );
+      out << indexMagic << endl;
+      out << "@ " << historyFile_r.ino() << " " << _parsed << endl;
+      for ( const auto & n : _data )
+      {
+        const std::string & name { str::stripPrefix( IdString(n.first).asString(), "patch:" ) };
+        for ( const auto & v : n.second )
+        {
+          for ( const auto & a : v.second )
+          {
+            out << name << "|" << Edition(v.first) << "|" << Arch(IdString(a.first)) << "|"
+                << Date::ValueType(a.second.first) << "|" << ResStatus::validateValueAsString( a.second.second ) << endl;
+          }
+        }
+      }
+      if ( ! out )
+      {
+        DBG << "Can't write patch history index " << tmpfile << endl;
+        filesystem::unlink( tmpfile );
+        return;
+      }
+    }
+    filesystem::rename( tmpfile, index_r );
   }
 
   const PatchHistoryData::value_type & get( const sat::Solvable & solv_r  ) const
@@ -262,7 +382,11 @@ private:
   template <class Tv>
   using MapType = std::unordered_map<IdType,Tv>;
 
+  static constexpr const char * indexMagic = "# zypper patch history index 1";
+
   MapType<MapType<MapType<value_type>>> _data; 	///> N V A ids to value_type
+  off_t _parsed = 0;	///< history file parsed up to this position
+  off_t _loaded = 0;	///< position remembered in the loaded index
 };
 
 const PatchHistoryData::value_type PatchHistoryData::noData( Date(), ResStatus::UNDETERMINED );
@@ -274,17 +398,34 @@ PatchHistoryData::PatchHistoryData( bool doparse_r )
 {
   if ( doparse_r )
   {
-    const Pathname & historyFile { Pathname::assertprefix( Zypper::instance().config().root_dir, ZConfig::instance().historyLogFile() ) };
-    parser::HistoryLogReader parser( historyFile, parser::HistoryLogReader::IGNORE_INVALID_ITEMS,
-                                     [=]( HistoryLogData::Ptr ptr_r )->bool {
-                                       if ( ! this->_d )
-                                         this->_d.reset( new D );
-                                       this->_d->remember( dynamic_pointer_cast<HistoryLogPatchStateChange>(ptr_r) );
-                                       return true;
-                                     } );
-    parser.addActionFilter( HistoryActionID::PATCH_STATE_CHANGE );
-    parser.readAll();
+    const Config & config { Zypper::instance().config() };
+    load( Pathname::assertprefix( config.root_dir, ZConfig::instance().historyLogFile() ),
+          Pathname::assertprefix( config.root_dir, config.rm_options.repoCachePath ) / "zypper" / "patch-history.index",
+          ! Zypper::instance().runtimeData().snapshot_read );	// no cache writes without the zypp lock
+  }
+}
+
+PatchHistoryData::PatchHistoryData( const Pathname & historyFile_r, const Pathname & indexFile_r )
+{ load( historyFile_r, indexFile_r, true ); }
+
+void PatchHistoryData::load( const Pathname & historyFile_r, const Pathname & indexFile_r, bool saveIndex_r )
+{
+  PathInfo historyInfo { historyFile_r };
+  if ( ! historyInfo.isFile() )
+    return;
+
+  RW_pointer<D> data { new D };
+  if ( ! data->loadIndex( indexFile_r, historyInfo ) )
+  {
+    DBG << "Rebuild patch history index " << indexFile_r << endl;
+    data.reset( new D );
   }
+  data->parseHistory( historyFile_r );
+  if ( saveIndex_r )
+    data->saveIndex( indexFile_r, historyInfo );
+
+  if ( ! data->empty() )
+    _d = data;
 }
 
 PatchHistoryData::operator bool() const
@@ -656,6 +797,34 @@ Pathname cache_rpm( const std::string & rpm_uri_str, const Pathname & cache_dir
   return Pathname();
 }
 
+bool fileMatchesChecksum( const Pathname & file_r, const CheckSum & checksum_r )
+{ return PathInfo( file_r ).isFile() && filesystem::checksum( file_r, checksum_r.type() ) == checksum_r.checksum(); }
+
+bool isDownloadedRepomdType( const std::string & type_r )
+{
+  static const std::set<std::string> known {
+    "primary", "filelists", "updateinfo", "patterns", "patches", "product", "products", "deltainfo", "susedata"
+  };
+  if ( known.count( type_r ) )
+    return true;
+  if ( ! str::hasPrefix( type_r, "susedata." ) )
+    return false;
+
+  static const std::set<std::string> wantedLocales { []() {
+    std::set<std::string> ret;
+    LocaleSet locales { ZConfig::instance().repoRefreshLocales() };
+    if ( locales.empty() )
+      locales.insert( ZConfig::instance().textLocale() );
+    for ( Locale locale : locales )
+    {
+      for ( ; locale != Locale::noCode; locale = locale.fallback() )
+        ret.insert( locale.code() );
+    }
+    return ret;
+  }() };
+  return wantedLocales.count( type_r.substr( 9 ) );
+}
+
 std::string indent( std::string text, int columns )
 {
   std::string indent( columns, ' ' );
@@ -14,6 +14,7 @@
 #include <list>
 
 #include <zypp/Url.h>
+#include <zypp/CheckSum.h>
 #include <zypp/Date.h>
 #include <zypp/Pathname.h>
 
@@ -140,6 +141,9 @@ public:
   /** Ctor parsing the history file. */
   PatchHistoryData() : PatchHistoryData( true ) {}
 
+  /** Ctor parsing \a historyFile_r, using and updating the index \a indexFile_r. */
+  PatchHistoryData( const Pathname & historyFile_r, const Pathname & indexFile_r );
+
   /** Return an empty instance without data. */
   static PatchHistoryData placeholder();
 
@@ -154,6 +158,7 @@ public:
 
 private:
   PatchHistoryData( bool );
+  void load( const Pathname & historyFile_r, const Pathname & indexFile_r, bool saveIndex_r );
   struct D;
   RW_pointer<D> _d;
 };
@@ -217,6 +222,15 @@ bool looks_like_rpm_file( const std::string & s );
  */
 Pathname cache_rpm( const std::string & rpm_uri_str, const Pathname & cache_dir );
 
+/** Whether \a file_r exists and matches \a checksum_r. */
+bool fileMatchesChecksum( const Pathname & file_r, const CheckSum & checksum_r );
+
+/** Whether libzypp downloads the rpm-md resource \a type_r listed in repomd.xml.
+ * Like libzypp's yum downloader: known resource types only, \c susedata.<lang>
+ * only for the wanted locales (zypp.conf:repo.refresh.locales and fallbacks).
+ */
+bool isDownloadedRepomdType( const std::string & type_r );
+
 /// Indent each line in \a text to \a columns
 std::string indent( std::string text, int columns );
 
@@ -5,6 +5,11 @@
                              |__/|_|  |_|
 \*---------------------------------------------------------------------------*/
 
+#include <fstream>
+#include <sstream>
+
+#include <zypp/AutoDispose.h>
+
 #include "TestSetup.h"
 #include "PackageArgs.h"
 
@@ -280,4 +285,34 @@ BOOST_AUTO_TEST_CASE(kind_tests)
   }
 }
 
+BOOST_AUTO_TEST_CASE(args_file)
+{
+  const char * content =
+    "# packages for the build host\n"
+    "vim  zypper>1.4.0   # editor and package manager\n"
+    "\n"
+    "   \n"
+    "libzypp\n"
+    "\t emacs #vi\n"
+    "#   gvim\n";
+  const std::vector<std::string> expected { "vim", "zypper>1.4.0", "libzypp", "emacs" };
+
+  filesystem::TmpFile file;
+  {
+    std::ofstream out( file.path().c_str() );
+    out << content;
+  }
+  BOOST_CHECK( PackageArgs::readArgsFile( file.path() ) == expected );
+
+  // '-' reads stdin
+  std::istringstream in( content );
+  {
+    // restore std::cin even if readArgsFile throws
+    AutoDispose<std::streambuf *> cinbuf { std::cin.rdbuf( in.rdbuf() ), []( std::streambuf * buf_r ) { std::cin.rdbuf( buf_r ); } };
+    BOOST_CHECK( PackageArgs::readArgsFile( "-" ) == expected );
+  }
+
+  BOOST_CHECK_THROW( PackageArgs::readArgsFile( file.path() / "nonexistent" ), Exception );
+}
+
 // vim: set ts=2 sts=8 sw=2 ai et:
@@ -0,0 +1,81 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include <fstream>
+#include <sstream>
+
+#include <zypp/TmpPath.h>
+
+#include "TestSetup.h"
+#include "utils/misc.h"
+
+using namespace zypp;
+
+namespace
+{
+  // as written by libzypp (the action field is padded)
+  const char * history =
+    "# 2023-05-10 10:11:10 zypper patch\n"
+    "2023-05-10 10:11:11|command|root@host|'zypper' 'patch'|\n"
+    "2023-05-10 10:11:12|patch  |openSUSE-2023-123|1|noarch|repo-update|important|security|needed|applied|\n"
+    "2023-05-10 10:11:13|install|vim|9.0.1-1.1|x86_64|root@host|repo-update|0123456789abcdef|\n"
+    "2023-05-10 10:11:14|patch  |openSUSE-2023-124|1|noarch|repo-update|moderate|recommended|needed|applied|\n";
+
+  const char * appended =
+    "2023-05-11 08:00:00|patch  |openSUSE-2023-200|1|noarch|repo-update|low|optional|needed|applied|\n";
+
+  std::string readFile( const Pathname & file_r )
+  {
+    std::ifstream in( file_r.c_str() );
+    std::ostringstream ret;
+    ret << in.rdbuf();
+    return ret.str();
+  }
+
+  void appendFile( const Pathname & file_r, const char * content_r )
+  {
+    std::ofstream out( file_r.c_str(), std::ios_base::app );
+    out << content_r;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(patch_history_index)
+{
+  filesystem::TmpDir tmp;
+  const Pathname & historyFile { tmp.path() / "history" };
+  const Pathname & indexFile { tmp.path() / "patch-history.index" };
+
+  appendFile( historyFile, history );
+  {
+    PatchHistoryData data( historyFile, indexFile );
+    BOOST_CHECK( data );
+  }
+  std::string index { readFile( indexFile ) };
+  BOOST_CHECK( index.find( "\nopenSUSE-2023-123|1|noarch|" ) != std::string::npos );
+  BOOST_CHECK( index.find( "\nopenSUSE-2023-124|1|noarch|" ) != std::string::npos );
+  BOOST_CHECK( index.find( "vim" ) == std::string::npos );
+
+  // entries appended to the history are added to the index
+  appendFile( historyFile, appended );
+  {
+    PatchHistoryData data( historyFile, indexFile );
+    BOOST_CHECK( data );
+  }
+  index = readFile( indexFile );
+  BOOST_CHECK( index.find( "\nopenSUSE-2023-123|1|noarch|" ) != std::string::npos );
+  BOOST_CHECK( index.find( "\nopenSUSE-2023-200|1|noarch|" ) != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE(patch_history_without_patches)
+{
+  filesystem::TmpDir tmp;
+  const Pathname & historyFile { tmp.path() / "history" };
+  appendFile( historyFile, "2023-05-10 10:11:13|install|vim|9.0.1-1.1|x86_64|root@host|repo-update|0123456789abcdef|\n" );
+
+  PatchHistoryData data( historyFile, tmp.path() / "patch-history.index" );
+  BOOST_CHECK( ! data );
+}
@@ -0,0 +1,83 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+#include "TestSetup.h"
+#include "RepoIndex.h"
+
+using namespace zypp;
+
+namespace
+{
+  RepoInfo makeRepo( const std::string & alias_r, const std::string & name_r, const std::string & url_r )
+  {
+    RepoInfo repo;
+    repo.setAlias( alias_r );
+    repo.setName( name_r );
+    repo.setType( repo::RepoType::RPMMD );
+    repo.addBaseUrl( Url( url_r ) );
+    return repo;
+  }
+
+  /** The alias of \a repo_r or "-" if there is none. */
+  inline std::string alias( const RepoInfo * repo_r )
+  { return repo_r ? repo_r->alias() : "-"; }
+}
+
+BOOST_AUTO_TEST_CASE(repo_index_find)
+{
+  TestSetup test;
+  RepoManager manager( test.repomanager() );
+  // repos are numbered in alias order
+  manager.addRepository( makeRepo( "a-repo", "b-repo", "http://example.com/a" ) );	// #1
+  manager.addRepository( makeRepo( "b-repo", "main", "http://example.com/b" ) );	// #2
+  manager.addRepository( makeRepo( "c-repo", "2", "http://example.com/c" ) );		// #3
+  manager.addRepository( makeRepo( "d-repo", "main", "http://example.com/d" ) );	// #4
+
+  RepoIndex index( manager );
+  BOOST_CHECK_EQUAL( index.size(), 4 );
+
+  BOOST_CHECK_EQUAL( alias( index.find( "c-repo" ) ), "c-repo" );	// alias
+  BOOST_CHECK_EQUAL( alias( index.find( "4" ) ), "d-repo" );		// number
+  BOOST_CHECK_EQUAL( alias( index.find( "main" ) ), "b-repo" );	// name, lowest number
+  // several repos match, the lowest number wins
+  BOOST_CHECK_EQUAL( alias( index.find( "b-repo" ) ), "a-repo" );	// name of #1, alias of #2
+  BOOST_CHECK_EQUAL( alias( index.find( "2" ) ), "b-repo" );		// number 2, name of #3
+
+  BOOST_CHECK_EQUAL( alias( index.find( "0" ) ), "-" );
+  BOOST_CHECK_EQUAL( alias( index.find( "5" ) ), "-" );
+  BOOST_CHECK_EQUAL( alias( index.find( "e-repo" ) ), "-" );
+}
+
+BOOST_AUTO_TEST_CASE(repo_index_find_url)
+{
+  TestSetup test;
+  RepoManager manager( test.repomanager() );
+  manager.addRepository( makeRepo( "a-repo", "A", "https://user@example.com/repo/?auth=token" ) );
+  manager.addRepository( makeRepo( "b-repo", "B", "https://example.com/other" ) );
+
+  RepoIndex index( manager );
+  // trailing slashes are ignored (bnc #585082)
+  BOOST_CHECK_EQUAL( alias( index.findUrl( Url( "https://user@example.com/repo?auth=token" ) ) ), "a-repo" );
+  BOOST_CHECK_EQUAL( alias( index.findUrl( Url( "https://example.com/other/" ) ) ), "b-repo" );
+
+  const Url & noAuth { "https://example.com/repo/?auth=token" };
+  BOOST_CHECK_EQUAL( alias( index.findUrl( noAuth ) ), "-" );
+  BOOST_CHECK_EQUAL( alias( index.findUrl( noAuth, /*looseQuery*/false, /*looseAuth*/true ) ), "a-repo" );
+
+  const Url & noQuery { "https://user@example.com/repo/" };
+  BOOST_CHECK_EQUAL( alias( index.findUrl( noQuery ) ), "-" );
+  BOOST_CHECK_EQUAL( alias( index.findUrl( noQuery, /*looseQuery*/true, /*looseAuth*/false ) ), "a-repo" );
+
+  const Url & bare { "https://example.com/repo" };
+  BOOST_CHECK_EQUAL( alias( index.findUrl( bare, true, false ) ), "-" );
+  BOOST_CHECK_EQUAL( alias( index.findUrl( bare, false, true ) ), "-" );
+  BOOST_CHECK_EQUAL( alias( index.findUrl( bare, true, true ) ), "a-repo" );
+
+  BOOST_CHECK_EQUAL( alias( index.findUrl( Url( "https://example.org/repo" ), true, true ) ), "-" );
+}
+
+// vim: set ts=2 sts=8 sw=2 ai et:
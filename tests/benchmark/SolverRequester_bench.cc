@@ -0,0 +1,218 @@
+/*---------------------------------------------------------------------------*\
+                          ____  _ _ __ _ __  ___ _ _
+                         |_ / || | '_ \ '_ \/ -_) '_|
+                         /__|\_, | .__/ .__/\___|_|
+                             |__/|_|  |_|
+\*---------------------------------------------------------------------------*/
+
+/** \file tests/benchmark/SolverRequester_bench.cc
+ *
+ * Timing and allocation counts of the request processing on synthetic pools.
+ *
+ * For each pool size a repository with N packages and a fake @System with
+ * every other package installed in a lower version is generated below a
+ * TestSetup root. Then these operations are measured:
+ *
+ * - PackageArgs    parsing N/10 package names
+ * - install        SolverRequester::install of these names
+ * - remove         SolverRequester::remove of these names
+ * - search         substring and exact name PoolQueries
+ * - summary        resolving the install request and writing the Summary
+ *
+ * \code
+ *   SolverRequester_bench [POOLSIZE...]	# default: 10000 50000 200000
+ * \endcode
+ */
+
+#define INCLUDE_TESTSETUP_WITHOUT_BOOST
+#include "TestSetup.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+#include <zypp/PoolQuery.h>
+
+#include "PackageArgs.h"
+#include "SolverRequester.h"
+#include "Summary.h"
+
+extern ZYpp::Ptr God;
+
+///////////////////////////////////////////////////////////////////
+// count allocations
+///////////////////////////////////////////////////////////////////
+static std::atomic<unsigned long> allocations { 0 };
+
+void * operator new( std::size_t size_r )
+{
+  ++allocations;
+  if ( void * ptr = std::malloc( size_r ? size_r : 1 ) )
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete( void * ptr_r ) noexcept
+{ std::free( ptr_r ); }
+
+void operator delete( void * ptr_r, std::size_t ) noexcept
+{ std::free( ptr_r ); }
+
+///////////////////////////////////////////////////////////////////
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  /** Measure and print one operation processing \a items_r items. */
+  template <class TFnc>
+  void measure( const std::string & name_r, unsigned items_r, TFnc && fnc_r )
+  {
+    unsigned long allocs = allocations;
+    Clock::time_point start { Clock::now() };
+    fnc_r();
+    double ms = std::chrono::duration<double,std::milli>( Clock::now() - start ).count();
+    allocs = allocations - allocs;
+
+    cout << str::form( "  %-14s %8u items %10.1f ms %8.2f us/item %12lu allocs %8.1f allocs/item",
+                       name_r.c_str(), items_r, ms, items_r ? 1000.0 * ms / items_r : 0.0,
+                       allocs, items_r ? double(allocs) / items_r : 0.0 ) << endl;
+  }
+
+  inline std::string pkgName( unsigned idx_r )
+  { return str::form( "bench-pkg%06u", idx_r ); }
+
+  /** Write a rpm-md repo with \a size_r packages in \a version_r (every \a step_r'th package only). */
+  void writeRepo( const Pathname & dir_r, unsigned size_r, const std::string & version_r, unsigned step_r = 1 )
+  {
+    filesystem::assert_dir( dir_r / "repodata" );
+    {
+      std::ofstream repomd( ( dir_r / "repodata/repomd.xml" ).c_str() );
+      repomd << "<?xml version=\"1.0\" ?>\n"
+             << "<repomd xmlns=\"http://linux.duke.edu/metadata/repo\">\n"
+             << "  <data type=\"primary\"><location href=\"repodata/primary.xml\"/></data>\n"
+             << "</repomd>\n";
+    }
+
+    std::ofstream primary( ( dir_r / "repodata/primary.xml" ).c_str() );
+    primary << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<metadata xmlns=\"http://linux.duke.edu/metadata/common\" xmlns:rpm=\"http://linux.duke.edu/metadata/rpm\" packages=\"" << size_r/step_r << "\">\n";
+    for ( unsigned idx = 0; idx < size_r; idx += step_r )
+    {
+      const std::string & name { pkgName( idx ) };
+      primary << "<package type=\"rpm\"><name>" << name << "</name><arch>x86_64</arch>"
+              << "<version epoch=\"0\" ver=\"" << version_r << "\" rel=\"1\"/>"
+              << "<summary>Synthetic package " << idx << "</summary><description>Benchmark package.</description>"
+              << "<location href=\"x86_64/" << name << ".rpm\"/><size package=\"1000\" installed=\"4000\" archive=\"4000\"/>"
+              << "<format><rpm:vendor>bench</rpm:vendor><rpm:provides>"
+              << "<rpm:entry name=\"" << name << "\" flags=\"EQ\" epoch=\"0\" ver=\"" << version_r << "\" rel=\"1\"/>"
+              << "<rpm:entry name=\"bench-cap(" << idx << ")\"/>"
+              << "</rpm:provides>";
+      if ( idx )	// a simple dependency chain
+        primary << "<rpm:requires><rpm:entry name=\"bench-cap(" << idx/2 << ")\"/></rpm:requires>";
+      primary << "</format></package>\n";
+    }
+    primary << "</metadata>\n";
+  }
+
+  void resetTransactions()
+  {
+    for ( const PoolItem & pi : God->pool() )
+      pi.status().resetTransact( ResStatus::USER );
+  }
+
+  void runBenchmark( unsigned size_r )
+  {
+    cout << "Pool of " << size_r << " packages:" << endl;
+    TestSetup test( Arch_x86_64 );
+    writeRepo( test.root() / "bench-repo", size_r, "2.0" );
+    writeRepo( test.root() / "bench-system", size_r, "1.0", 2 );
+
+    measure( "load", size_r + size_r/2, [&]() {
+      test.loadTargetRepo( test.root() / "bench-system" );
+      test.loadRepo( test.root() / "bench-repo", "bench" );
+      test.poolProxy();
+    } );
+
+    std::vector<std::string> names;
+    for ( unsigned idx = 0; idx < size_r; idx += 10 )
+      names.push_back( pkgName( idx ) );
+
+    std::unique_ptr<PackageArgs> args;
+    measure( "PackageArgs", names.size(), [&]() {
+      args.reset( new PackageArgs( names ) );
+    } );
+
+    measure( "install", names.size(), [&]() {
+      SolverRequester sr;
+      sr.install( *args );
+    } );
+    resetTransactions();
+
+    PackageArgs::Options argopts;
+    argopts.do_by_default = false;
+    PackageArgs rmargs( names, ResKind::package, argopts );
+    measure( "remove", names.size(), [&]() {
+      SolverRequester sr;
+      sr.remove( rmargs );
+    } );
+    resetTransactions();
+
+    measure( "search exact", 100, [&]() {
+      for ( unsigned idx = 0; idx < 100; ++idx )
+      {
+        PoolQuery q;
+        q.addAttribute( sat::SolvAttr::name, pkgName( idx * ( size_r / 100 ) ) );
+        q.setMatchExact();
+        q.size();
+      }
+    } );
+
+    measure( "search substr", 10, [&]() {
+      for ( unsigned idx = 0; idx < 10; ++idx )
+      {
+        PoolQuery q;
+        q.addAttribute( sat::SolvAttr::name, str::numstring( idx ) + "9" );
+        q.setMatchSubstring();
+        q.size();
+      }
+    } );
+
+    {
+      SolverRequester sr;
+      sr.install( *args );
+    }
+    measure( "resolve", names.size(), [&]() {
+      God->resolver()->resolvePool();
+    } );
+    measure( "summary", names.size(), [&]() {
+      Summary summary( God->pool(), SummaryHints() );
+      std::ostringstream out;
+      summary.dumpTo( out );
+    } );
+    resetTransactions();
+    cout << endl;
+  }
+
+} // namespace
+///////////////////////////////////////////////////////////////////
+
+int main( int argc, char * argv[] )
+{
+  std::vector<unsigned> sizes;
+  for ( int i = 1; i < argc; ++i )
+    sizes.push_back( str::strtonum<unsigned>( argv[i] ) );
+  if ( sizes.empty() )
+    sizes = { 10000, 50000, 200000 };
+
+  God = getZYpp();
+  for ( unsigned size : sizes )
+  {
+    // The pool is a singleton: clear it from the previous run.
+    sat::Pool::instance().reposEraseAll();
+    runBenchmark( size );
+  }
+  return 0;
+}